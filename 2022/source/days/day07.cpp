@@ -1,181 +1,179 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
+#include <charconv>
 #include <cstdlib>
-#include <list>
+#include <limits>
 #include <numeric>
-#include <ranges>
-#include <stack>
+#include <stdexcept>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
 
-struct File {
-    File() = default;
-    File(std::string name, const uint32_t size) : name(std::move(name)), size(size) {}
+using NodeId = uint32_t;
 
-    std::string name;
-    uint32_t size{0U};
+struct DirectoryNode {
+    NodeId parent{0U};
+    uint32_t nameId{0U};
+    uint64_t totalSize{0U};
+    bool listed{false};
 };
 
-struct Directory {
-    Directory() = default;
-    Directory(std::string name, Directory* parent) : name(std::move(name)), parent(parent) {}
+// Directory tree stored as a flat node table. Names are interned once and children are found through a hash keyed
+// by (parent, name), so entering a directory does not scan its siblings. Every file size is added to all
+// directories on the current path as soon as it is listed, so the totals are final once the log has been read.
+class FileSystem {
+  public:
+    static constexpr NodeId ROOT = 0U;
 
-    std::string name;
-    std::list<Directory> directories;
-    std::list<File> files;
-    Directory* parent{nullptr};
-    uint32_t totalSize{0U};
-};
-
-auto parse(const std::filesystem::path& filePath) {
-    static constexpr std::size_t BUFFER_SIZE = 10000;
-
-    std::vector<std::string> input;
-    const auto lineCallback = [&input](const std::string& line) { input.push_back(line); };
-    parseInput(filePath, lineCallback);
-    return input;
-}
+    FileSystem() { mNodes.push_back({ROOT, internName("/"), 0U, false}); }
 
-Directory* parseEnterDirectoryLine(Directory& root,
-                                   Directory* const currentDirectory,
-                                   const std::string& directoryName) {
-    static constexpr std::string_view directoryUpName{".."};
-
-    if (directoryName == root.name) {
-        return &root;
-    } else if (directoryName == directoryUpName) {
-        return currentDirectory->parent;
-    } else {
-        const auto iter =
-            std::find_if(currentDirectory->directories.begin(), currentDirectory->directories.end(),
-                         [&directoryName](const Directory& directory) { return directoryName == directory.name; });
-        if (iter != currentDirectory->directories.end()) {
-            return &*iter;
+    void changeDirectory(const std::string_view name) {
+        if (name == "/") {
+            mCurrent = ROOT;
+        } else if (name == "..") {
+            mCurrent = mNodes[mCurrent].parent;
         } else {
-            throw std::runtime_error("Unknown directory");
+            const auto iter = mChildren.find(childKey(mCurrent, internName(name)));
+            if (iter == mChildren.end()) {
+                throw std::runtime_error("Unknown directory");
+            }
+            mCurrent = iter->second;
         }
     }
-}
 
-void parseListDirectoryLine(Directory* const currentDirectory, const std::string& line) {
-    static constexpr std::string_view directoryEntry{"dir "};
+    // Directories listed a second time already hold their file sizes; only new subdirectories are recorded.
+    void startListing() {
+        mSkipFiles = mNodes[mCurrent].listed;
+        mNodes[mCurrent].listed = true;
+    }
 
-    if (line.starts_with(directoryEntry)) {
-        const std::string directoryName = line.substr(directoryEntry.size(), line.size() - directoryEntry.size());
-        const auto iter =
-            std::find_if(currentDirectory->directories.begin(), currentDirectory->directories.end(),
-                         [&directoryName](const Directory& directory) { return directoryName == directory.name; });
-        if (iter == currentDirectory->directories.end()) {
-            currentDirectory->directories.emplace_back(directoryName, currentDirectory);
+    void addDirectory(const std::string_view name) {
+        const auto nameId = internName(name);
+        const auto [iter, inserted] = mChildren.try_emplace(childKey(mCurrent, nameId), 0U);
+        if (inserted) {
+            iter->second = static_cast<NodeId>(mNodes.size());
+            mNodes.push_back({mCurrent, nameId, 0U, false});
         }
-    } else {
-        const auto parts = split(line, " ");
-        const auto iter = std::find_if(currentDirectory->files.begin(), currentDirectory->files.end(),
-                                       [name = parts[1]](const File& file) { return name == file.name; });
-        if (iter == currentDirectory->files.end()) {
-            currentDirectory->files.emplace_back(parts[1], std::stoul(parts[0]));
+    }
+
+    void addFile(const uint64_t size) {
+        if (mSkipFiles) {
+            return;
         }
+
+        for (auto node = mCurrent; node != ROOT; node = mNodes[node].parent) {
+            mNodes[node].totalSize += size;
+        }
+        mNodes[ROOT].totalSize += size;
+    }
+
+    [[nodiscard]] const std::vector<DirectoryNode>& directories() const { return mNodes; }
+
+  private:
+    static uint64_t childKey(const NodeId parent, const uint32_t nameId) {
+        return (static_cast<uint64_t>(parent) << 32U) | nameId;
+    }
+
+    uint32_t internName(const std::string_view name) {
+        const auto [iter, inserted] = mNameIds.try_emplace(std::string(name), static_cast<uint32_t>(mNameIds.size()));
+        return iter->second;
+    }
+
+    std::vector<DirectoryNode> mNodes;
+    std::unordered_map<std::string, uint32_t> mNameIds;
+    std::unordered_map<uint64_t, NodeId> mChildren;
+    NodeId mCurrent{ROOT};
+    bool mSkipFiles{false};
+};
+
+uint64_t parseFileSize(const std::string_view line) {
+    uint64_t size = 0U;
+    const auto [end, error] = std::from_chars(line.data(), line.data() + line.size(), size);
+    if (error != std::errc() || end == line.data() || *end != ' ') {
+        throw std::runtime_error("Invalid line");
     }
+    return size;
 }
 
-void buildDirectoryTree(Directory& root, const std::vector<std::string>& input) {
+auto parse(const std::filesystem::path& filePath) {
     static constexpr std::string_view commandListDirectory{"$ ls"};
-    static constexpr std::string_view commandEnterDirectory{"$ cd"};
-
-    Directory* currentDirectory = nullptr;
+    static constexpr std::string_view commandEnterDirectory{"$ cd "};
+    static constexpr std::string_view directoryEntry{"dir "};
 
-    enum class Command { CD, LS };
-    std::optional<Command> lastCommand;
-    for (const auto& line : input) {
-        if (line.empty()) {
-            continue;
+    FileSystem fileSystem;
+    bool listing = false;
+    const auto lineCallback = [&fileSystem, &listing](const std::string& line) {
+        const std::string_view view(line);
+        if (view.empty()) {
+            return;
         }
 
-        if (line.starts_with(commandListDirectory)) {
-            lastCommand = Command::LS;
-        } else if (line.starts_with(commandEnterDirectory)) {
-            lastCommand = Command::CD;
-            const auto headerSize = commandEnterDirectory.size() + 1;
-            const auto directoryName = line.substr(headerSize, line.size() - headerSize);
-            currentDirectory = parseEnterDirectoryLine(root, currentDirectory, directoryName);
-        } else if (lastCommand.has_value()) {
-            switch (*lastCommand) {
-                case Command::LS:
-                    parseListDirectoryLine(currentDirectory, line);
-                    break;
-                default:
-                    throw std::runtime_error("Invalid last command");
-            }
-        } else {
+        if (view.starts_with(commandListDirectory)) {
+            listing = true;
+            fileSystem.startListing();
+        } else if (view.starts_with(commandEnterDirectory)) {
+            listing = false;
+            fileSystem.changeDirectory(view.substr(commandEnterDirectory.size()));
+        } else if (!listing) {
             throw std::runtime_error("Invalid line");
+        } else if (view.starts_with(directoryEntry)) {
+            fileSystem.addDirectory(view.substr(directoryEntry.size()));
+        } else {
+            fileSystem.addFile(parseFileSize(view));
         }
-    }
+    };
+    parseInput(filePath, lineCallback);
+    return fileSystem;
 }
 
-void calculateDirectorySizes(Directory& directory) {
-    for (const auto& file : directory.files) {
-        directory.totalSize += file.size;
-    }
+uint64_t sumSmallDirectories(const FileSystem& fileSystem) {
+    static constexpr uint64_t smallDirectorySizeThreshold = 100000U;
 
-    for (auto& childDirectory : directory.directories) {
-        calculateDirectorySizes(childDirectory);
-        directory.totalSize += childDirectory.totalSize;
-    }
+    const auto& directories = fileSystem.directories();
+    return std::accumulate(directories.cbegin(), directories.cend(), uint64_t{0U},
+                           [](const uint64_t sum, const DirectoryNode& directory) {
+                               return directory.totalSize <= smallDirectorySizeThreshold ? sum + directory.totalSize
+                                                                                         : sum;
+                           });
 }
 
-void collectDirectories(Directory& directory, std::vector<Directory*>& directoriesToCollect) {
-    directoriesToCollect.push_back(&directory);
+uint64_t findSmallestDirectoryToDelete(const FileSystem& fileSystem) {
+    static constexpr uint64_t filesystemSize = 70000000U;
+    static constexpr uint64_t sizeNeededForUpdate = 30000000U;
+
+    const auto& directories = fileSystem.directories();
+    const auto usedSpace = directories[FileSystem::ROOT].totalSize;
+    if (usedSpace > filesystemSize) {
+        throw std::logic_error("Filesystem is larger than the disk");
+    }
+    const auto spaceFree = filesystemSize - usedSpace;
+    if (spaceFree >= sizeNeededForUpdate) {
+        return 0U;
+    }
+    const auto spaceNeeded = sizeNeededForUpdate - spaceFree;
 
-    for (auto& childDirectory : directory.directories) {
-        collectDirectories(childDirectory, directoriesToCollect);
+    auto smallest = std::numeric_limits<uint64_t>::max();
+    for (const auto& directory : directories) {
+        if (directory.totalSize >= spaceNeeded) {
+            smallest = std::min(smallest, directory.totalSize);
+        }
     }
+    return smallest;
 }
 }  // namespace
 
 std::pair<std::string, std::string> day07() {
-    const auto input = parse("resources/day07.txt");
-
-    Directory root;
-    root.name = "/";
-    root.parent = &root;
-
-    buildDirectoryTree(root, input);
-    calculateDirectorySizes(root);
-
-    std::vector<Directory*> allDirectories;
-    static constexpr size_t expectedNumberOfDirectories = 1000U;
-    allDirectories.reserve(expectedNumberOfDirectories);
-    collectDirectories(root, allDirectories);
-    std::sort(allDirectories.begin(), allDirectories.end(),
-              [](const Directory* first, const Directory* second) { return first->totalSize < second->totalSize; });
-
-    static constexpr uint32_t smallDirectorySizeThreshold = 100000U;
-
-    const auto sumOfDirectoriesSmallSizes = std::accumulate(
-        allDirectories.cbegin(), allDirectories.cend(), 0U, [](const uint32_t sum, const Directory* directory) {
-            if (directory->totalSize <= smallDirectorySizeThreshold) {
-                return sum + directory->totalSize;
-            } else {
-                return sum;
-            }
-        });
-
-    static constexpr uint32_t filesystemSize = 70000000U;
-    static constexpr uint32_t sizeNeededForUpdate = 30000000U;
-
-    const uint32_t spaceFree = filesystemSize - root.totalSize;
-    const uint32_t spaceNeeded = sizeNeededForUpdate - spaceFree;
+    const auto fileSystem = parse("resources/day07.txt");
 
-    const auto iter = std::find_if(allDirectories.cbegin(), allDirectories.cend(),
-                                   [spaceNeeded](const Directory* dir) { return dir->totalSize >= spaceNeeded; });
+    const auto sumOfDirectoriesSmallSizes = sumSmallDirectories(fileSystem);
+    const auto sizeOfDirectoryToDelete = findSmallestDirectoryToDelete(fileSystem);
 
-    return {std::to_string(sumOfDirectoriesSmallSizes), std::to_string((*iter)->totalSize)};
+    return {std::to_string(sumOfDirectoriesSmallSizes), std::to_string(sizeOfDirectoryToDelete)};
 }
 }  // namespace bblp::aoc
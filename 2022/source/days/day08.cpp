@@ -2,14 +2,19 @@
 
 #include "bblp/aoc/file_utils.hpp"
 #include "bblp/aoc/grid.hpp"
+#include "bblp/aoc/parallel.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstdlib>
 #include <numeric>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
+constexpr int32_t NUMBER_OF_HEIGHTS = 10;
 
 auto parse(const std::filesystem::path& filePath) {
     static constexpr std::size_t BUFFER_SIZE = 10000;
@@ -20,149 +25,103 @@ auto parse(const std::filesystem::path& filePath) {
     int32_t height = 0;
 
     const auto lineCallback = [&tiles, &width, &height](const std::string& line) {
-        if (!line.empty()) {
-            width = static_cast<int32_t>(line.size());
-            ++height;
-            tiles.append(line);
+        if (line.empty()) {
+            return;
         }
+        if (std::any_of(line.cbegin(), line.cend(), [](const char tree) { return tree < '0' || tree > '9'; })) {
+            throw std::logic_error("Invalid tree height in line: " + line);
+        }
+
+        width = static_cast<int32_t>(line.size());
+        ++height;
+        tiles.append(line);
     };
     parseInput(filePath, lineCallback);
     return Grid<char>(width, height, {tiles.begin(), tiles.end()});
 }
 
-bool isTreeVisibleFromLeft(const int32_t x, const int32_t y, const Grid<char>& grid) {
-    char largestTree = -1;
-    for (auto index = 0; index < x; ++index) {
-        if (grid.at(index, y) > largestTree) {
-            largestTree = grid.at(index, y);
-        }
-    }
-    return grid.at(x, y) > largestTree;
-}
-
-bool isTreeVisibleFromRight(const int32_t x, const int32_t y, const Grid<char>& grid) {
-    char largestTree = -1;
-    for (auto index = grid.width() - 1; index > x; --index) {
-        if (grid.at(index, y) > largestTree) {
-            largestTree = grid.at(index, y);
-        }
+// Visibility and viewing distances along one line of trees, looking both ways. A tree is visible when it is
+// taller than the running maximum from either end; its viewing distance ends at the nearest tree at least as tall,
+// found from the last position seen for each of the ten heights. Heights nobody has reached yet point at the edge,
+// which is exactly as far as the view goes without a blocker.
+void sweepLine(const std::span<const char> trees, const std::span<uint8_t> visible, const std::span<uint32_t> score) {
+    const auto size = trees.size();
+
+    int32_t tallest = -1;
+    std::array<std::size_t, NUMBER_OF_HEIGHTS> lastSeen{};
+    lastSeen.fill(0U);
+    for (std::size_t i = 0U; i < size; ++i) {
+        const int32_t height = trees[i] - '0';
+        visible[i] = static_cast<uint8_t>(height > tallest);
+        tallest = std::max(tallest, height);
+
+        const auto blocker = *std::max_element(lastSeen.cbegin() + height, lastSeen.cend());
+        score[i] = static_cast<uint32_t>(i - blocker);
+        lastSeen[static_cast<std::size_t>(height)] = i;
     }
-    return grid.at(x, y) > largestTree;
-}
 
-bool isTreeVisibleFromTop(const int32_t x, const int32_t y, const Grid<char>& grid) {
-    char largestTree = -1;
-    for (auto index = 0; index < y; ++index) {
-        if (grid.at(x, index) > largestTree) {
-            largestTree = grid.at(x, index);
-        }
-    }
-    return grid.at(x, y) > largestTree;
-}
+    tallest = -1;
+    lastSeen.fill(size - 1U);
+    for (std::size_t i = size; i-- > 0U;) {
+        const int32_t height = trees[i] - '0';
+        visible[i] |= static_cast<uint8_t>(height > tallest);
+        tallest = std::max(tallest, height);
 
-bool isTreeVisibleFromBottom(const int32_t x, const int32_t y, const Grid<char>& grid) {
-    char largestTree = -1;
-    for (auto index = grid.height() - 1; index > y; --index) {
-        if (grid.at(x, index) > largestTree) {
-            largestTree = grid.at(x, index);
-        }
+        const auto blocker = *std::min_element(lastSeen.cbegin() + height, lastSeen.cend());
+        score[i] *= static_cast<uint32_t>(blocker - i);
+        lastSeen[static_cast<std::size_t>(height)] = i;
     }
-    return grid.at(x, y) > largestTree;
 }
 
-bool isTreeVisible(const int32_t x, int32_t y, const Grid<char>& grid) {
-    if (x == 0 || y == 0 || x == grid.width() - 1 || y == grid.height() - 1) {
-        return true;
-    }
-
-    return isTreeVisibleFromLeft(x, y, grid) || isTreeVisibleFromRight(x, y, grid) ||
-           isTreeVisibleFromTop(x, y, grid) || isTreeVisibleFromBottom(x, y, grid);
-}
+struct ForestSummary {
+    int64_t visibleTrees{0};
+    int64_t highestScenicScore{0};
 
-int32_t countVisibleTrees(const Grid<char>& grid) {
-    int32_t numberOfVisibleTrees = 0;
-    for (auto x = 0; x < grid.width(); ++x) {
-        for (auto y = 0; y < grid.height(); ++y) {
-            if (isTreeVisible(x, y, grid)) {
-                ++numberOfVisibleTrees;
-            }
-        }
+    ForestSummary& operator+=(const ForestSummary& other) {
+        visibleTrees += other.visibleTrees;
+        highestScenicScore = std::max(highestScenicScore, other.highestScenicScore);
+        return *this;
     }
-    return numberOfVisibleTrees;
-}
-
-int32_t findNumberOfTreesVisibleLeft(const int32_t x, const int32_t y, const Grid<char>& grid) {
-    int32_t numberOfTreesVisible = 0;
-    for (auto index = x - 1; index >= 0; --index) {
-        ++numberOfTreesVisible;
-        if (grid.at(index, y) >= grid.at(x, y)) {
-            break;
+};
+
+// Columns are swept as rows of the transposed forest first; the row sweep then combines both results per tree.
+ForestSummary summarizeForest(const Grid<char>& grid) {
+    const auto width = static_cast<std::size_t>(grid.width());
+    const auto height = static_cast<std::size_t>(grid.height());
+
+    const auto columns = grid.transposed();
+    std::vector<uint8_t> visibleInColumn(width * height);
+    std::vector<uint32_t> scoreInColumn(width * height);
+    parallelFor(width, [&](const std::size_t begin, const std::size_t end) {
+        for (auto x = begin; x < end; ++x) {
+            sweepLine(columns.row(static_cast<int64_t>(x)), std::span(visibleInColumn).subspan(x * height, height),
+                      std::span(scoreInColumn).subspan(x * height, height));
         }
-    }
-    return numberOfTreesVisible;
-}
-
-int32_t findNumberOfTreesVisibleRight(const int32_t x, const int32_t y, const Grid<char>& grid) {
-    int32_t numberOfTreesVisible = 0;
-    for (auto index = x + 1; index < grid.width(); ++index) {
-        ++numberOfTreesVisible;
-        if (grid.at(index, y) >= grid.at(x, y)) {
-            break;
-        }
-    }
-    return numberOfTreesVisible;
-}
-
-int32_t findNumberOfTreesVisibleTop(const int32_t x, const int32_t y, const Grid<char>& grid) {
-    int32_t numberOfTreesVisible = 0;
-    for (auto index = y - 1; index >= 0; --index) {
-        ++numberOfTreesVisible;
-        if (grid.at(x, index) >= grid.at(x, y)) {
-            break;
-        }
-    }
-    return numberOfTreesVisible;
-}
-
-int32_t findNumberOfTreesVisibleBottom(const int32_t x, const int32_t y, const Grid<char>& grid) {
-    int32_t numberOfTreesVisible = 0;
-    for (auto index = y + 1; index < grid.height(); ++index) {
-        ++numberOfTreesVisible;
-        if (grid.at(x, index) >= grid.at(x, y)) {
-            break;
-        }
-    }
-    return numberOfTreesVisible;
-}
-
-int32_t calculateScenicScore(const int32_t x, const int32_t y, const Grid<char>& grid) {
-    if (x == 0 || y == 0) {
-        return 0;
-    }
-
-    return findNumberOfTreesVisibleLeft(x, y, grid) * findNumberOfTreesVisibleRight(x, y, grid) *
-           findNumberOfTreesVisibleTop(x, y, grid) * findNumberOfTreesVisibleBottom(x, y, grid);
-}
-
-int32_t findHighestScenicScore(const Grid<char>& grid) {
-    int32_t highestScenicScore = 0;
-    for (auto x = 0; x < grid.width(); ++x) {
-        for (auto y = 0; y < grid.height(); ++y) {
-            const int32_t currentScore = calculateScenicScore(x, y, grid);
-            if (currentScore > highestScenicScore) {
-                highestScenicScore = currentScore;
+    });
+
+    return parallelSum<ForestSummary>(height, [&](const std::size_t begin, const std::size_t end) {
+        ForestSummary summary;
+        std::vector<uint8_t> visibleInRow(width);
+        std::vector<uint32_t> scoreInRow(width);
+        for (auto y = begin; y < end; ++y) {
+            sweepLine(grid.row(static_cast<int64_t>(y)), visibleInRow, scoreInRow);
+            for (std::size_t x = 0; x < width; ++x) {
+                const auto column = x * height + y;
+                summary.visibleTrees += (visibleInRow[x] | visibleInColumn[column]) != 0U ? 1 : 0;
+                summary.highestScenicScore =
+                    std::max(summary.highestScenicScore,
+                             static_cast<int64_t>(scoreInRow[x]) * static_cast<int64_t>(scoreInColumn[column]));
             }
         }
-    }
-    return highestScenicScore;
+        return summary;
+    });
 }
 }  // namespace
 
 std::pair<std::string, std::string> day08() {
     const auto input = parse("resources/day08.txt");
-    const auto treesVisible = countVisibleTrees(input);
-    const auto highestScenicScore = findHighestScenicScore(input);
+    const auto summary = summarizeForest(input);
 
-    return {std::to_string(treesVisible), std::to_string(highestScenicScore)};
+    return {std::to_string(summary.visibleTrees), std::to_string(summary.highestScenicScore)};
 }
 }  // namespace bblp::aoc
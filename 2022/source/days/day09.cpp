@@ -5,10 +5,9 @@
 #include <algorithm>
 #include <array>
 #include <cstdlib>
-#include <functional>
 #include <numeric>
+#include <unordered_set>
 #include <vector>
-#include <set>
 
 namespace bblp::aoc {
 namespace {
@@ -29,17 +28,6 @@ struct Command {
 
 struct Point {
     [[nodiscard]] bool operator==(const Point& other) const noexcept { return (x == other.x) && (y == other.y); };
-    [[nodiscard]] bool operator<(const Point& other) const noexcept { 
-        if (x != other.x) {
-            return x < other.x;
-        }
-
-        return y < other.y;
-    }
-
-    [[nodiscard]] int32_t distanceTo(const Point& other) const noexcept {
-        return std::max(std::abs(x - other.x), std::abs(y - other.y));
-    }
 
     [[nodiscard]] bool isAdjacentTo(const Point& other) const noexcept {
         return (std::abs(x - other.x)) <= 1 && (std::abs(y - other.y) <= 1);
@@ -90,57 +78,102 @@ auto parse(const std::filesystem::path& filePath) {
     return input;
 }
 
-void movePosition(Point& position, const Direction direction) {
+Point directionOffset(const Direction direction) {
     switch (direction) {
         case Direction::RIGHT:
-            position.x += 1;
-            break;
+            return {1, 0};
         case Direction::LEFT:
-            position.x -= 1;
-            break;
+            return {-1, 0};
         case Direction::UP:
-            position.y += 1;
-            break;
+            return {0, 1};
         case Direction::DOWN:
-            position.y -= 1;
-            break;
+            return {0, -1};
         default:
             throw std::runtime_error("Invalid direction");
     }
 }
 
-size_t calculateVisitedPositionsPart1(const std::vector<Command>& input) {
-    Point headPosition;
-    Point tailPosition;
-    std::set<Point> visitedPositions;
+struct Bounds {
+    Point min;
+    Point max;
+
+    [[nodiscard]] int64_t width() const { return static_cast<int64_t>(max.x) - min.x + 1; }
+    [[nodiscard]] int64_t height() const { return static_cast<int64_t>(max.y) - min.y + 1; }
+};
+
+// Every knot trails the head and so never leaves the box spanned by the head's path.
+Bounds findHeadBounds(const std::vector<Command>& input) {
+    Point head;
+    Bounds bounds{head, head};
     for (const auto& command : input) {
-        for (auto i = 0U; i < command.distance; ++i) {
-            const Point currentHeadPosition = headPosition;
-            movePosition(headPosition, command.direction);
-            if ((tailPosition != currentHeadPosition) && (tailPosition.distanceTo(headPosition) > 1)) {
-                tailPosition = currentHeadPosition;
-            }
+        const auto offset = directionOffset(command.direction);
+        head.x += offset.x * command.distance;
+        head.y += offset.y * command.distance;
+        bounds.min = {std::min(bounds.min.x, head.x), std::min(bounds.min.y, head.y)};
+        bounds.max = {std::max(bounds.max.x, head.x), std::max(bounds.max.y, head.y)};
+    }
+    return bounds;
+}
 
-            visitedPositions.insert(tailPosition);
+// Set of visited positions: a bitmap over the bounding box when it is small enough, a hash set otherwise.
+class VisitedPositions {
+  public:
+    explicit VisitedPositions(const Bounds& bounds) : mBounds(bounds) {
+        static constexpr int64_t MAX_DENSE_AREA = int64_t{1} << 28;
+
+        if (bounds.width() * bounds.height() <= MAX_DENSE_AREA) {
+            mBits.resize(static_cast<std::size_t>((bounds.width() * bounds.height() + 63) / 64), 0U);
         }
     }
-    return visitedPositions.size();
-}
 
-size_t calculateVisitedPositionsPart2(const std::vector<Command>& input) {
-    static constexpr size_t ropeLength = 10;
+    void insert(const Point& position) {
+        const auto index = static_cast<uint64_t>(position.y - mBounds.min.y) * static_cast<uint64_t>(mBounds.width()) +
+                           static_cast<uint64_t>(position.x - mBounds.min.x);
+        if (mBits.empty()) {
+            if (mSparse.insert(index).second) {
+                ++mSize;
+            }
+            return;
+        }
 
-    std::array<Point, ropeLength> snake;
-    std::set<Point> visitedPositions;
+        auto& word = mBits[index / 64];
+        const auto bit = uint64_t{1} << (index % 64);
+        mSize += (word & bit) == 0U ? 1U : 0U;
+        word |= bit;
+    }
+
+    [[nodiscard]] std::size_t size() const { return mSize; }
+
+  private:
+    Bounds mBounds;
+    std::vector<uint64_t> mBits;
+    std::unordered_set<uint64_t> mSparse;
+    std::size_t mSize{0};
+};
+
+// Moves the rope one step at a time. A knot that stays adjacent to its leader does not move, and then neither does
+// any knot behind it, so the update stops there.
+template <std::size_t RopeLength>
+std::size_t calculateVisitedPositions(const std::vector<Command>& input, const Bounds& bounds) {
+    static_assert(RopeLength >= 2, "A rope needs a head and a tail");
+
+    std::array<Point, RopeLength> knots{};
+    VisitedPositions visitedPositions(bounds);
+    visitedPositions.insert(knots.back());
 
     for (const auto& command : input) {
+        const auto offset = directionOffset(command.direction);
         for (auto i = 0; i < command.distance; ++i) {
-            movePosition(snake.back(), command.direction);
-            for (auto iter = snake.rbegin() + 1; iter != snake.rend(); ++iter) {
-                iter->follow(*std::prev(iter));
-            }
+            knots.front().x += offset.x;
+            knots.front().y += offset.y;
 
-            visitedPositions.insert(snake.front());
+            std::size_t knot = 1;
+            for (; knot < RopeLength && !knots[knot].isAdjacentTo(knots[knot - 1]); ++knot) {
+                knots[knot].follow(knots[knot - 1]);
+            }
+            if (knot == RopeLength) {
+                visitedPositions.insert(knots.back());
+            }
         }
     }
     return visitedPositions.size();
@@ -150,8 +183,10 @@ size_t calculateVisitedPositionsPart2(const std::vector<Command>& input) {
 std::pair<std::string, std::string> day09() {
     const auto input = parse("resources/day09.txt");
 
-    const auto visitedPositionsPart1 = calculateVisitedPositionsPart1(input);
-    const auto visitedPositionsPart2 = calculateVisitedPositionsPart2(input);
+    const auto bounds = findHeadBounds(input);
+
+    const auto visitedPositionsPart1 = calculateVisitedPositions<2>(input, bounds);
+    const auto visitedPositionsPart2 = calculateVisitedPositions<10>(input, bounds);
 
     return {std::to_string(visitedPositionsPart1), std::to_string(visitedPositionsPart2)};
 }
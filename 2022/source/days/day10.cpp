@@ -3,16 +3,19 @@
 #include "bblp/aoc/file_utils.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstdlib>
 #include <iostream>
-#include <sstream>
 #include <numeric>
+#include <sstream>
+#include <string_view>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
 constexpr int32_t CRT_WIDTH = 40;
 
+// The value of each instruction is its latency in cycles.
 enum class Instruction { NOOP = 1, ADDX = 2 };
 
 auto parse(const std::filesystem::path& filePath) {
@@ -35,141 +38,120 @@ auto parse(const std::filesystem::path& filePath) {
     return input;
 }
 
-int32_t calculateSignalStrength(const std::vector<std::pair<Instruction, int32_t>>& input) {
-    static constexpr int32_t CYCLE_START = 20;
-    static constexpr int32_t CYCLE_DIFF = 40;
+// Value of the X register during every cycle of the program: trace[cycle - 1]. Consumers read the trace instead
+// of executing the program again.
+std::vector<int32_t> traceRegister(const std::vector<std::pair<Instruction, int32_t>>& input) {
+    const auto cycleCount = std::accumulate(
+        input.cbegin(), input.cend(), std::size_t{0},
+        [](const std::size_t sum, const auto& command) { return sum + static_cast<std::size_t>(command.first); });
 
-    int32_t signalStrength = 0;
+    std::vector<int32_t> trace;
+    trace.reserve(cycleCount);
     int32_t registerValue = 1;
-    int32_t cycleNumber = 0;
-    for (const auto& command : input) {
-        cycleNumber++;
-        switch (command.first) {
-            case Instruction::NOOP: {
-                if ((cycleNumber + CYCLE_START) % CYCLE_DIFF == 0) {
-                    const int32_t current = CYCLE_START * ((cycleNumber + 1) / CYCLE_START) * registerValue;
-                    signalStrength += current;
-                }
-            } break;
-            case Instruction::ADDX: {
-                if (((cycleNumber + CYCLE_START) % CYCLE_DIFF == CYCLE_DIFF - 1) ||
-                    ((cycleNumber + CYCLE_START) % CYCLE_DIFF == 0)) {
-                    const int32_t current = CYCLE_START * ((cycleNumber + 2) / CYCLE_START) * registerValue;
-                    signalStrength += current;
-                }
-                cycleNumber++;
-                registerValue += command.second;
-            } break;
+    for (const auto& [instruction, argument] : input) {
+        trace.insert(trace.end(), static_cast<std::size_t>(instruction), registerValue);
+        if (instruction == Instruction::ADDX) {
+            registerValue += argument;
         }
     }
-    return signalStrength;
+    return trace;
 }
 
-void printSpritePosition(std::ostream& stream, const int32_t registerValue) {
-    stream << "Sprite position:  ";
-    for (auto i = 0; i < CRT_WIDTH; ++i) {
-        if (i == registerValue - 1 || i == registerValue || i == registerValue + 1) {
-            stream << "#";
-        } else {
-            stream << ".";
-        }
+int64_t calculateSignalStrength(const std::vector<int32_t>& trace, const std::size_t firstCycle,
+                                const std::size_t period) {
+    int64_t signalStrength = 0;
+    for (auto cycle = firstCycle; cycle <= trace.size(); cycle += period) {
+        signalStrength += static_cast<int64_t>(cycle) * trace[cycle - 1];
     }
-    stream << "\n\n";
-}
-
-void printStartCycle(std::ostream& stream, const int32_t cycleNumber) {
-    stream << "Start cycle  " << std::setw(3) << cycleNumber << ": ";
-}
-
-void printDuringCycle(std::ostream& stream, const int32_t cycleNumber) {
-    stream << "During cycle " << std::setw(3) << cycleNumber << ": ";
-}
-
-void printEndOfCycle(std::ostream& stream, const int32_t cycleNumber) {
-    stream << "End of cycle " << std::setw(3) << cycleNumber << ": ";
+    return signalStrength;
 }
 
-void printCrtRow(std::ostream& stream, const std::vector<char>& crt, const int32_t start) {
-    stream << "Current CRT row : ";
-    for (auto iter = crt.begin() + start; iter != crt.end(); ++iter) {
-        stream << *iter;
+// One pixel per cycle, drawn row by row; a pixel is lit when the three-wide sprite centred on X covers it.
+std::string renderCrt(const std::vector<int32_t>& trace) {
+    std::string framebuffer(trace.size(), '.');
+    for (std::size_t cycle = 0; cycle < trace.size(); ++cycle) {
+        const auto column = static_cast<int32_t>(cycle % CRT_WIDTH);
+        if (std::abs(trace[cycle] - column) <= 1) {
+            framebuffer[cycle] = '#';
+        }
     }
-    stream << '\n';
+    return framebuffer;
 }
 
-void drawAtPosition(std::ostream& stream, std::vector<char>& crt, const int32_t registerValue, const int32_t crtPosition) {
-    stream << "CRT draws pixel in position " << crtPosition << '\n';
-    if (crtPosition == registerValue - 1 || crtPosition == registerValue || crtPosition == registerValue + 1) {
-        crt.emplace_back('#');
-    } else {
-        crt.emplace_back('.');
+struct Glyph {
+    char letter;
+    std::string_view pixels;
+};
+
+constexpr int32_t GLYPH_WIDTH = 4;
+constexpr int32_t GLYPH_HEIGHT = 6;
+constexpr int32_t GLYPH_SPACING = 5;
+
+// 4x6 font used by the puzzle, row by row.
+constexpr std::array<Glyph, 18> GLYPHS{{
+    {'A', ".##.#..##..######..##..#"},
+    {'B', "###.#..####.#..##..####."},
+    {'C', ".##.#..##...#...#..#.##."},
+    {'E', "#####...###.#...#...####"},
+    {'F', "#####...###.#...#...#..."},
+    {'G', ".##.#..##...#.###..#.###"},
+    {'H', "#..##..######..##..##..#"},
+    {'I', ".###..#...#...#...#..###"},
+    {'J', "..##...#...#...##..#.##."},
+    {'K', "#..##.#.##..#.#.#.#.#..#"},
+    {'L', "#...#...#...#...#...####"},
+    {'O', ".##.#..##..##..##..#.##."},
+    {'P', "###.#..##..####.#...#..."},
+    {'R', "###.#..##..####.#.#.#..#"},
+    {'S', ".####...#....##....####."},
+    {'U', "#..##..##..##..##..#.##."},
+    {'Z', "####...#..#..#..#...####"},
+    {'?', ""},
+}};
+
+// Reads the letters of a rendered screen; unknown glyphs come back as '?'.
+std::string readLetters(const std::string_view framebuffer) {
+    const auto height = static_cast<int32_t>(framebuffer.size() / CRT_WIDTH);
+    if (height < GLYPH_HEIGHT) {
+        return {};
     }
-}
 
-std::vector<char> calculateCrtOutput(const std::vector<std::pair<Instruction, int32_t>>& input, std::ostream& stream) {
-    static constexpr size_t BUFFER_SIZE = 10000;
-
-    int32_t registerValue = 1;
-    int32_t cycleNumber = 0;
-    std::vector<char> crt;
-    crt.reserve(BUFFER_SIZE);
-
-    printSpritePosition(stream, registerValue);
-    for (const auto& command : input) {
-        cycleNumber++;
-        printStartCycle(stream, cycleNumber);
-        switch (command.first) {
-            case Instruction::NOOP:
-                stream << "begin executing noop\n";
-
-                drawAtPosition(stream, crt, registerValue, (cycleNumber - 1) % CRT_WIDTH);
-                printCrtRow(stream, crt, CRT_WIDTH * (cycleNumber / CRT_WIDTH));
-                stream << '\n';
-                break;
-
-            case Instruction::ADDX:
-                stream << "begin executing addx " << command.second << '\n';
-                printDuringCycle(stream, cycleNumber);
-                drawAtPosition(stream, crt, registerValue, (cycleNumber - 1) % CRT_WIDTH);
-                printCrtRow(stream, crt, CRT_WIDTH * (cycleNumber / CRT_WIDTH));
-
-                cycleNumber++;
-                stream << '\n';
-                printDuringCycle(stream, cycleNumber);
-                drawAtPosition(stream, crt, registerValue, (cycleNumber - 1) % CRT_WIDTH);
-                printCrtRow(stream, crt, CRT_WIDTH * (cycleNumber / CRT_WIDTH));
-
-                registerValue += command.second;
-                printEndOfCycle(stream, cycleNumber);
-                stream << "finish executing addx " << command.second << " (Register X is now " << registerValue
-                          << ")\n";
-                break;
+    std::string letters;
+    for (int32_t left = 0; left + GLYPH_WIDTH <= CRT_WIDTH; left += GLYPH_SPACING) {
+        std::string pixels;
+        for (int32_t row = 0; row < GLYPH_HEIGHT; ++row) {
+            pixels.append(framebuffer.substr(static_cast<std::size_t>(row * CRT_WIDTH + left), GLYPH_WIDTH));
         }
-
-        printSpritePosition(stream, registerValue);
+        const auto glyph = std::find_if(GLYPHS.cbegin(), GLYPHS.cend() - 1,
+                                        [&pixels](const Glyph& candidate) { return candidate.pixels == pixels; });
+        letters.push_back(glyph->letter);
     }
+    return letters;
+}
 
-    for (auto i = 0U; i < crt.size(); ++i) {
-        if (i % CRT_WIDTH == 0) {
-            stream << '\n';
-        }
-        stream << crt.at(i);
+void printCrt(std::ostream& stream, const std::string_view framebuffer) {
+    for (std::size_t start = 0; start < framebuffer.size(); start += CRT_WIDTH) {
+        stream << framebuffer.substr(start, CRT_WIDTH) << '\n';
     }
-    stream << '\n';
-    return crt;
+    stream << "Letters: " << readLetters(framebuffer) << '\n';
 }
 }  // namespace
 
 std::pair<std::string, std::string> day10(const bool printOutput) {
-    std::ostringstream stream;
+    static constexpr std::size_t SIGNAL_FIRST_CYCLE = 20U;
+    static constexpr std::size_t SIGNAL_PERIOD = 40U;
 
     const auto input = parse("resources/day10.txt");
-    const auto signalStrength = calculateSignalStrength(input);
-    const auto crtOutput = calculateCrtOutput(input, stream);
+    const auto trace = traceRegister(input);
+
+    const auto signalStrength = calculateSignalStrength(trace, SIGNAL_FIRST_CYCLE, SIGNAL_PERIOD);
+    const auto crtOutput = renderCrt(trace);
     if (printOutput) {
+        std::ostringstream stream;
+        printCrt(stream, crtOutput);
         std::cout << stream.str() << '\n';
     }
 
-    return {std::to_string(signalStrength), std::string{crtOutput.begin(), crtOutput.end()}};
+    return {std::to_string(signalStrength), crtOutput};
 }
 }  // namespace bblp::aoc
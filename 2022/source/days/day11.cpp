@@ -1,31 +1,83 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
+#include "bblp/aoc/parallel.hpp"
 #include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
-#include <array>
 #include <cstdlib>
-#include <iostream>
 #include <numeric>
+#include <stdexcept>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
 
 using MonkeyId = int32_t;
+using WorryLevel = uint64_t;
 
-struct Monkey {
-    using WorryLevel = uint64_t;
+enum class OperationKind { Add, Multiply, Square };
+
+struct Operation {
+    OperationKind kind{OperationKind::Add};
+    WorryLevel operand{0};
+
+    WorryLevel apply(const WorryLevel level) const {
+        switch (kind) {
+            case OperationKind::Add:
+                return level + operand;
+            case OperationKind::Multiply:
+                return level * operand;
+            case OperationKind::Square:
+                return level * level;
+        }
+        return level;
+    }
+};
+
+// Ring buffer of worry levels, reserved up front for every item in play so the rounds never reallocate.
+class ItemQueue {
+  public:
+    void reserve(const std::size_t capacity) { mItems.resize(capacity); }
+
+    void push(const WorryLevel item) {
+        if (mSize == mItems.size()) {
+            mItems.resize(std::max<std::size_t>(1U, mItems.size() * 2U));
+            std::rotate(mItems.begin(), mItems.begin() + mHead, mItems.begin() + mSize);
+            mHead = 0;
+        }
+        mItems[(mHead + mSize) % mItems.size()] = item;
+        ++mSize;
+    }
+
+    WorryLevel pop() {
+        const auto item = mItems[mHead];
+        mHead = (mHead + 1) % mItems.size();
+        --mSize;
+        return item;
+    }
+
+    [[nodiscard]] bool empty() const { return mSize == 0; }
+    [[nodiscard]] std::size_t size() const { return mSize; }
 
-    std::list<WorryLevel> items;
-    std::function<WorryLevel(WorryLevel)> operation;
-    std::function<bool(WorryLevel)> test;
+  private:
+    std::vector<WorryLevel> mItems;
+    std::size_t mHead{0};
+    std::size_t mSize{0};
+};
+
+struct Monkey {
+    std::vector<WorryLevel> startingItems;
+    Operation operation;
+    WorryLevel testDivisor{1};
     MonkeyId monkeyToThrowToIfTrue{0};
     MonkeyId monkeyToThrowToIfFalse{0};
-    uint64_t numberOfInspectedItems{0};
-    int32_t reducer{0};
+
+    MonkeyId throwTarget(const WorryLevel level) const {
+        return level % testDivisor == 0 ? monkeyToThrowToIfTrue : monkeyToThrowToIfFalse;
+    }
 };
 
 auto parse(const std::filesystem::path& filePath) {
@@ -39,114 +91,197 @@ auto parse(const std::filesystem::path& filePath) {
 
     std::vector<Monkey> input;
     input.reserve(BUFFER_SIZE);
-    Monkey* lastMonkey = nullptr;
-    const auto lineCallback = [&input, &lastMonkey](const std::string& line) {
+    const auto lineCallback = [&input](const std::string& line) {
         if (line.empty()) {
             return;
         }
 
         if (line.find(MONKEY_STRING) != std::string::npos) {
             input.emplace_back();
-            lastMonkey = &input.back();
-        } else if (const auto itemsPos = line.find(ITEMS_STRING); itemsPos != std::string::npos) {
+            return;
+        }
+        if (input.empty()) {
+            throw std::logic_error("Monkey attribute before monkey header");
+        }
+
+        auto& monkey = input.back();
+        if (const auto itemsPos = line.find(ITEMS_STRING); itemsPos != std::string::npos) {
             const auto items = split(line.substr(itemsPos + ITEMS_STRING.size()), ",");
             for (const auto& item : items) {
-                lastMonkey->items.emplace_back(std::stol(item));
+                monkey.startingItems.emplace_back(std::stoull(item));
             }
         } else if (const auto operationPos = line.find(OPERATION_STRING); operationPos != std::string::npos) {
             if (const auto multiPos = line.find('*'); multiPos != std::string::npos) {
-                if (const auto oldPos = line.find("old", multiPos); oldPos != std::string::npos) {
-                    lastMonkey->operation = [](const Monkey::WorryLevel level) -> Monkey::WorryLevel {
-                        return level * level;
-                    };
+                if (line.find("old", multiPos) != std::string::npos) {
+                    monkey.operation = {OperationKind::Square, 0};
                 } else {
-                    const auto val = std::stol(line.substr(multiPos + 1));
-                    lastMonkey->operation = [val](const Monkey::WorryLevel level) -> Monkey::WorryLevel {
-                        return level * val;
-                    };
+                    monkey.operation = {OperationKind::Multiply, std::stoull(line.substr(multiPos + 1))};
                 }
             } else if (const auto addPos = line.find('+'); addPos != std::string::npos) {
-                const auto val = std::stol(line.substr(addPos + 1));
-                lastMonkey->operation = [val](const Monkey::WorryLevel level) -> Monkey::WorryLevel {
-                    return level + val;
-                };
+                monkey.operation = {OperationKind::Add, std::stoull(line.substr(addPos + 1))};
+            } else {
+                throw std::logic_error("Unknown operation: " + line);
             }
         } else if (const auto testPos = line.find(TEST_STRING); testPos != std::string::npos) {
-            const auto val = std::stol(line.substr(testPos + TEST_STRING.size()));
-            lastMonkey->test = [val](const Monkey::WorryLevel level) -> bool { return level % val == 0; };
-            lastMonkey->reducer = val;
+            monkey.testDivisor = std::stoull(line.substr(testPos + TEST_STRING.size()));
         } else if (const auto ifTruePos = line.find(IF_TRUE_STRING); ifTruePos != std::string::npos) {
-            const auto val = std::stol(line.substr(ifTruePos + IF_TRUE_STRING.size()));
-            lastMonkey->monkeyToThrowToIfTrue = val;
+            monkey.monkeyToThrowToIfTrue = std::stoi(line.substr(ifTruePos + IF_TRUE_STRING.size()));
         } else if (const auto ifFalsePos = line.find(IF_FALSE_STRING); ifFalsePos != std::string::npos) {
-            const auto val = std::stol(line.substr(ifFalsePos + IF_FALSE_STRING.size()));
-            lastMonkey->monkeyToThrowToIfFalse = val;
+            monkey.monkeyToThrowToIfFalse = std::stoi(line.substr(ifFalsePos + IF_FALSE_STRING.size()));
         }
     };
     parseInput(filePath, lineCallback);
     return input;
 }
 
-int32_t calculateReducer(const std::vector<Monkey>& monkeys) {
-    return std::accumulate(monkeys.cbegin(), monkeys.cend(), 1,
-                           [](const int32_t mul, const Monkey& monkey) -> int32_t { return mul * monkey.reducer; });
+WorryLevel calculateReducer(const std::vector<Monkey>& monkeys) {
+    return std::accumulate(monkeys.cbegin(), monkeys.cend(), WorryLevel{1},
+                           [](const WorryLevel mul, const Monkey& monkey) { return mul * monkey.testDivisor; });
 }
 
-void transferItems(std::list<Monkey::WorryLevel>& destination,
-                   std::list<Monkey::WorryLevel>::const_iterator begin,
-                   std::list<Monkey::WorryLevel>::const_iterator end) {
-    destination.insert(destination.end(), std::move(begin), std::move(end));
+struct InspectionCounts {
+    std::vector<uint64_t> counts;
+
+    InspectionCounts& operator+=(const InspectionCounts& other) {
+        counts.resize(std::max(counts.size(), other.counts.size()), 0U);
+        std::transform(other.counts.cbegin(), other.counts.cend(), counts.cbegin(), counts.begin(), std::plus<>());
+        return *this;
+    }
+};
+
+uint64_t calculateMonkeyBusiness(InspectionCounts inspections) {
+    auto& counts = inspections.counts;
+    if (counts.size() < 2) {
+        throw std::logic_error("Monkey business needs at least two monkeys");
+    }
+
+    std::partial_sort(counts.begin(), counts.begin() + 2, counts.end(), std::greater<>());
+    return counts[0] * counts[1];
 }
 
-uint64_t calculateMonkeyBusiness(const std::vector<Monkey>& input,
-                                 const int32_t numberOfRounds,
-                                 const int32_t divisor,
-                                 const int32_t reducer) {
-    static constexpr std::array<int32_t, 12> roundsToPrint{1,    20,   1000, 2000, 3000, 4000,
-                                                           5000, 6000, 7000, 8000, 9000, 10000};
-
-    auto monkeys = std::vector<Monkey>(input);
-    for (int i = 1; i <= numberOfRounds; ++i) {
-        for (auto& monkey : monkeys) {
-            monkey.numberOfInspectedItems += monkey.items.size();
-
-            auto itemsToInspect = std::list<Monkey::WorryLevel>(monkey.items);
-            auto itemsToThrowIfTrue = std::list<Monkey::WorryLevel>();
-            auto itemsToThrowIfFalse = std::list<Monkey::WorryLevel>();
-            for (const uint64_t item : itemsToInspect) {
-                const uint64_t newItem = (monkey.operation(item) / divisor);
-                if (monkey.test(newItem)) {
-                    itemsToThrowIfTrue.emplace_back(newItem % reducer);
-                } else {
-                    itemsToThrowIfFalse.emplace_back(newItem % reducer);
-                }
+// Plays the rounds monkey by monkey, the way the puzzle describes them.
+InspectionCounts countInspectionsByRounds(const std::vector<Monkey>& monkeys,
+                                          const int64_t numberOfRounds,
+                                          const WorryLevel divisor,
+                                          const WorryLevel reducer) {
+    const auto itemCount = std::accumulate(monkeys.cbegin(), monkeys.cend(), std::size_t{0},
+                                           [](const std::size_t sum, const Monkey& monkey) {
+                                               return sum + monkey.startingItems.size();
+                                           });
+
+    std::vector<ItemQueue> queues(monkeys.size());
+    for (std::size_t id = 0; id < monkeys.size(); ++id) {
+        queues[id].reserve(itemCount);
+        for (const auto item : monkeys[id].startingItems) {
+            queues[id].push(item);
+        }
+    }
+
+    InspectionCounts inspections{std::vector<uint64_t>(monkeys.size(), 0U)};
+    for (int64_t round = 0; round < numberOfRounds; ++round) {
+        for (std::size_t id = 0; id < monkeys.size(); ++id) {
+            const auto& monkey = monkeys[id];
+            auto& queue = queues[id];
+            inspections.counts[id] += queue.size();
+            while (!queue.empty()) {
+                const auto level = monkey.operation.apply(queue.pop()) / divisor;
+                queues[monkey.throwTarget(level)].push(level % reducer);
             }
-            transferItems(monkeys[monkey.monkeyToThrowToIfTrue].items, itemsToThrowIfTrue.begin(),
-                          itemsToThrowIfTrue.end());
-            transferItems(monkeys[monkey.monkeyToThrowToIfFalse].items, itemsToThrowIfFalse.begin(),
-                          itemsToThrowIfFalse.end());
-            monkey.items.clear();
         }
     }
+    return inspections;
+}
 
-    std::sort(monkeys.begin(), monkeys.end(), [](const Monkey& lhs, const Monkey& rhs) {
-        return lhs.numberOfInspectedItems > rhs.numberOfInspectedItems;
-    });
+// Items never influence each other, so each one can be followed on its own. Its state at the start of a round is
+// the monkey holding it and its worry level modulo the reducer; once a state repeats, the remaining rounds are
+// whole cycles plus a prefix of one, read from the per-round inspection history.
+InspectionCounts countInspectionsOfItem(const std::vector<Monkey>& monkeys,
+                                        MonkeyId holder,
+                                        WorryLevel level,
+                                        const int64_t numberOfRounds,
+                                        const WorryLevel divisor,
+                                        const WorryLevel reducer) {
+    const auto monkeyCount = monkeys.size();
+    std::vector<uint64_t> history(monkeyCount, 0U);
+    std::unordered_map<WorryLevel, int64_t> roundOfState;
+    const auto stateKey = [monkeyCount](const MonkeyId monkey, const WorryLevel worry) {
+        return worry * monkeyCount + static_cast<WorryLevel>(monkey);
+    };
+    const auto countsAfter = [&history, monkeyCount](const int64_t round, const std::size_t monkey) {
+        return history[static_cast<std::size_t>(round) * monkeyCount + monkey];
+    };
 
-    return monkeys.front().numberOfInspectedItems * (monkeys.begin() + 1)->numberOfInspectedItems;
+    level %= reducer;
+    roundOfState.emplace(stateKey(holder, level), 0);
+    std::vector<uint64_t> counts(monkeyCount, 0U);
+    for (int64_t round = 1; round <= numberOfRounds; ++round) {
+        MonkeyId next = holder;
+        do {
+            holder = next;
+            ++counts[holder];
+            level = monkeys[holder].operation.apply(level) / divisor;
+            next = monkeys[holder].throwTarget(level);
+            level %= reducer;
+        } while (next > holder);
+        holder = next;
+        history.insert(history.end(), counts.cbegin(), counts.cend());
+
+        const auto [iter, inserted] = roundOfState.emplace(stateKey(holder, level), round);
+        if (inserted) {
+            continue;
+        }
+
+        const auto cycleStart = iter->second;
+        const auto cycleLength = round - cycleStart;
+        const auto remainingRounds = numberOfRounds - round;
+        const auto fullCycles = static_cast<uint64_t>(remainingRounds / cycleLength);
+        const auto partialCycle = cycleStart + remainingRounds % cycleLength;
+        for (std::size_t monkey = 0; monkey < monkeyCount; ++monkey) {
+            const auto perCycle = countsAfter(round, monkey) - countsAfter(cycleStart, monkey);
+            counts[monkey] += fullCycles * perCycle + countsAfter(partialCycle, monkey) -
+                              countsAfter(cycleStart, monkey);
+        }
+        break;
+    }
+    return {counts};
+}
+
+InspectionCounts countInspectionsByItems(const std::vector<Monkey>& monkeys,
+                                         const int64_t numberOfRounds,
+                                         const WorryLevel divisor,
+                                         const WorryLevel reducer) {
+    std::vector<std::pair<MonkeyId, WorryLevel>> items;
+    for (std::size_t id = 0; id < monkeys.size(); ++id) {
+        for (const auto item : monkeys[id].startingItems) {
+            items.emplace_back(static_cast<MonkeyId>(id), item);
+        }
+    }
+
+    auto inspections = parallelSum<InspectionCounts>(items.size(), [&](const std::size_t begin, const std::size_t end) {
+        InspectionCounts chunk{std::vector<uint64_t>(monkeys.size(), 0U)};
+        for (auto i = begin; i < end; ++i) {
+            chunk += countInspectionsOfItem(monkeys, items[i].first, items[i].second, numberOfRounds, divisor,
+                                            reducer);
+        }
+        return chunk;
+    });
+    inspections.counts.resize(monkeys.size(), 0U);
+    return inspections;
 }
 }  // namespace
 
 std::pair<std::string, std::string> day11() {
     const auto input = parse("resources/day11.txt");
-    static constexpr int32_t roundCountPart1 = 20;
-    static constexpr int32_t roundCountPart2 = 10000;
-    static constexpr int32_t divisorPart1 = 3;
-    static constexpr int32_t divisorPart2 = 1;
+    static constexpr int64_t roundCountPart1 = 20;
+    static constexpr int64_t roundCountPart2 = 10000;
+    static constexpr WorryLevel divisorPart1 = 3;
+    static constexpr WorryLevel divisorPart2 = 1;
 
     const auto reducer = calculateReducer(input);
-    const uint64_t monkeyBusinessPart1 = calculateMonkeyBusiness(input, roundCountPart1, divisorPart1, reducer);
-    const uint64_t monkeyBusinessPart2 = calculateMonkeyBusiness(input, roundCountPart2, divisorPart2, reducer);
+    const uint64_t monkeyBusinessPart1 =
+        calculateMonkeyBusiness(countInspectionsByRounds(input, roundCountPart1, divisorPart1, reducer));
+    const uint64_t monkeyBusinessPart2 =
+        calculateMonkeyBusiness(countInspectionsByItems(input, roundCountPart2, divisorPart2, reducer));
     return {std::to_string(monkeyBusinessPart1), std::to_string(monkeyBusinessPart2)};
 }
 }  // namespace bblp::aoc
@@ -6,16 +6,14 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <numeric>
-#include <queue>
+#include <stdexcept>
+#include <vector>
 
 namespace bblp::aoc {
 namespace {
-
-struct Step {
-    int32_t distance;
-    Point position;
-};
+constexpr int32_t UNREACHABLE = -1;
 
 auto parse(const std::filesystem::path& filePath) {
     static constexpr std::size_t BUFFER_SIZE = 10000;
@@ -36,70 +34,74 @@ auto parse(const std::filesystem::path& filePath) {
     return Grid<char>(width, height, {tiles.begin(), tiles.end()});
 }
 
-bool isMovePossible(const Point& target, const Grid<char>& grid) {
-    return target.x >= 0 && target.x < grid.width() && target.y >= 0 && target.y < grid.height();
-}
-
-bool isMovePossible(const Point& target, const Grid<char>& valueGrid, const Grid<bool>& visitedGrid, const char currentValue) {
-    if (target.x < 0 || target.x >= valueGrid.width() || target.y < 0 || target.y >= valueGrid.height()) {
-        return false;
+char heightOf(const char tile) {
+    if (tile == 'S') {
+        return 'a';
     }
-
-    if (visitedGrid.at(target)) {
-        return false;
+    if (tile == 'E') {
+        return 'z';
     }
-
-    auto targetValue = valueGrid.at(target);
-    if (targetValue == 'S') {
-        targetValue = 'a';
-    }
-
-    return targetValue >= currentValue - 1;
+    return tile;
 }
 
-int32_t findShortestPath(const Grid<char>& grid, const char destinationValue) {
-    const std::array<Point, 4> possibleMoves{Point(1, 0), Point(-1, 0), Point(0, 1), Point(0, -1)};
+// Distance from every cell to 'E', found with one BFS walking the climbing rules backwards: a step from a cell to
+// its neighbour is reversible when the neighbour is at most one lower. Cells that cannot reach 'E' stay UNREACHABLE.
+Grid<int32_t> buildDistanceField(const Grid<char>& grid) {
+    static constexpr std::array<Point, 4> POSSIBLE_MOVES{Point(1, 0), Point(-1, 0), Point(0, 1), Point(0, -1)};
+
     const auto end = grid.find('E');
     if (!end.has_value()) {
         throw std::runtime_error("End not found");
     }
 
-    Grid<bool> visited(grid.width(), grid.height(), false);
-    visited.set(end->x, end->y, true);
-
-    std::queue<Step> route;
-    route.push({0, *end});
-
-    while (!route.empty()) {
-        const auto& currentStep = route.front();
-        const auto currentPosition = currentStep.position;
-        const auto currentValue = grid.at(currentPosition);
-
-        if (currentValue == destinationValue) {
-            return currentStep.distance;
+    Grid<int32_t> distances(grid.width(), grid.height(), UNREACHABLE);
+    distances.set(*end, 0);
+
+    std::vector<Point> frontier{*end};
+    std::vector<Point> nextFrontier;
+    for (int32_t distance = 1; !frontier.empty(); ++distance) {
+        for (const auto& position : frontier) {
+            const auto currentHeight = heightOf(grid.at(position));
+            for (const auto& move : POSSIBLE_MOVES) {
+                const Point target(position.x + move.x, position.y + move.y);
+                if (target.x < 0 || target.x >= grid.width() || target.y < 0 || target.y >= grid.height() ||
+                    distances.at(target) != UNREACHABLE || heightOf(grid.at(target)) < currentHeight - 1) {
+                    continue;
+                }
+
+                distances.set(target, distance);
+                nextFrontier.push_back(target);
+            }
         }
+        frontier.swap(nextFrontier);
+        nextFrontier.clear();
+    }
+    return distances;
+}
 
-        for (const auto& possibleMove : possibleMoves) {
-            const Point target(currentPosition.x + possibleMove.x, currentPosition.y + possibleMove.y);
-
-            if (isMovePossible(target, grid, visited, currentValue)) {
-                visited.set(target, true);
-                route.push({currentStep.distance + 1, target});
+// Shortest distance to 'E' from any cell accepted by `isStart`, or UNREACHABLE.
+template <typename StartPredicate>
+int32_t findShortestPath(const Grid<char>& grid, const Grid<int32_t>& distances, StartPredicate isStart) {
+    int32_t result = UNREACHABLE;
+    for (int64_t y = 0; y < grid.height(); ++y) {
+        for (int64_t x = 0; x < grid.width(); ++x) {
+            const auto distance = distances.at(x, y);
+            if (distance != UNREACHABLE && isStart(grid.at(x, y)) && (result == UNREACHABLE || distance < result)) {
+                result = distance;
             }
         }
-
-        route.pop();
     }
-
-    return -1;
+    return result;
 }
 }  // namespace
 
 std::pair<std::string, std::string> day12() {
     const auto input = parse("resources/day12.txt");
+    const auto distances = buildDistanceField(input);
 
-    const auto shortestPathPart1 = findShortestPath(input, 'S');
-    const auto shortestPathPart2 = findShortestPath(input, 'a');
+    const auto shortestPathPart1 = findShortestPath(input, distances, [](const char tile) { return tile == 'S'; });
+    const auto shortestPathPart2 =
+        findShortestPath(input, distances, [](const char tile) { return heightOf(tile) == 'a'; });
 
     return {std::to_string(shortestPathPart1), std::to_string(shortestPathPart2)};
 }
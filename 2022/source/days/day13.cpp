@@ -1,171 +1,142 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
+#include <compare>
 #include <cstdlib>
 #include <iostream>
 #include <numeric>
-#include <variant>
+#include <span>
+#include <stdexcept>
+#include <string_view>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
-
-struct List;
-std::ostream& operator<<(std::ostream& stream, const List& list);
-
-struct List {
-    std::weak_ordering operator<=>(const List& other) const {
-        auto leftIter = content.cbegin();
-        auto rightIter = other.content.cbegin();
-
-        while (leftIter != content.cend() && rightIter != other.content.cend()) {
-            const bool isLeftInt = std::holds_alternative<int32_t>(*leftIter);
-            const bool isRightInt = std::holds_alternative<int32_t>(*rightIter);
-            if (isLeftInt && isRightInt) {
-                const auto leftInt = std::get<int32_t>(*leftIter);
-                const auto rightInt = std::get<int32_t>(*rightIter);
-                if (leftInt < rightInt) {
-                    return std::weak_ordering::less;
-                } else if (leftInt > rightInt) {
-                    return std::weak_ordering::greater;
-                }
-            } else if (!isLeftInt && !isRightInt) {
-                const std::weak_ordering cmp = std::get<List>(*leftIter) <=> std::get<List>(*rightIter);
-                if (cmp < 0) {
-                    return std::weak_ordering::less;
-                } else if (cmp > 0) {
-                    return std::weak_ordering::greater;
-                }
-            } else if (isLeftInt && !isRightInt) {
-                List leftList;
-                leftList.content.push_back(*leftIter);
-                const std::weak_ordering cmp = leftList <=> std::get<List>(*rightIter);
-                if (cmp < 0) {
-                    return std::weak_ordering::less;
-                } else if (cmp > 0) {
-                    return std::weak_ordering::greater;
+using Token = int32_t;
+
+constexpr Token OPEN = -1;
+constexpr Token CLOSE = -2;
+
+// Packets flattened into one token array: OPEN, CLOSE or a non-negative integer. Packet `i` spans
+// [offsets[i], offsets[i + 1]).
+class Packets {
+  public:
+    void add(const std::string_view line) {
+        int32_t depth = 0;
+        for (std::size_t i = 0; i < line.size(); ++i) {
+            const auto c = line[i];
+            if (c == '[') {
+                mTokens.push_back(OPEN);
+                ++depth;
+            } else if (c == ']') {
+                mTokens.push_back(CLOSE);
+                if (--depth < 0) {
+                    throw std::logic_error("Unbalanced packet: " + std::string(line));
                 }
-            } else if (!isLeftInt && isRightInt) {
-                List rightList;
-                rightList.content.push_back(*rightIter);
-                const std::weak_ordering cmp = std::get<List>(*leftIter) <=> rightList;
-                if (cmp < 0) {
-                    return std::weak_ordering::less;
-                } else if (cmp > 0) {
-                    return std::weak_ordering::greater;
+            } else if (c >= '0' && c <= '9') {
+                Token number = 0;
+                for (; i < line.size() && line[i] >= '0' && line[i] <= '9'; ++i) {
+                    number = number * 10 + (line[i] - '0');
                 }
-            } else {
-                throw std::runtime_error("what?");
+                --i;
+                mTokens.push_back(number);
+            } else if (c != ',') {
+                throw std::logic_error("Invalid packet character in line: " + std::string(line));
             }
-
-            ++leftIter;
-            ++rightIter;
-        }
-
-        if (leftIter == content.cend() && rightIter == other.content.cend()) {
-            return std::weak_ordering::equivalent;
         }
-
-        if (leftIter == content.end() && rightIter != other.content.end()) {
-            return std::weak_ordering::less;
-        }
-
-        if (leftIter != content.end() && rightIter == other.content.end()) {
-            return std::weak_ordering::greater;
+        if (depth != 0) {
+            throw std::logic_error("Unbalanced packet: " + std::string(line));
         }
-
-        return std::weak_ordering::equivalent;
+        mOffsets.push_back(mTokens.size());
     }
 
-    bool operator==(const List& other) const { return (*this <=> other) == std::weak_ordering::equivalent; }
+    [[nodiscard]] std::size_t size() const { return mOffsets.size() - 1; }
 
-    std::vector<std::variant<int32_t, List>> content;
-};
-
-struct Packet {
-    bool operator<(const Packet& other) const { return items < other.items; }
-    bool operator<=(const Packet& other) const { return items <= other.items; }
-    bool operator==(const Packet& other) const { return items == other.items; }
+    [[nodiscard]] std::span<const Token> at(const std::size_t index) const {
+        return std::span(mTokens).subspan(mOffsets[index], mOffsets[index + 1] - mOffsets[index]);
+    }
 
-    List items;
+  private:
+    std::vector<Token> mTokens;
+    std::vector<std::size_t> mOffsets{0};
 };
 
-std::ostream& operator<<(std::ostream& stream, const List& list) {
-    std::cout << "[";
-    for (auto iter = list.content.begin(); iter != list.content.cend(); ++iter) {
-        if (iter != list.content.begin()) {
-            std::cout << ',';
+// Walks both token streams together. When a list meets an integer, the integer is treated as a one-element list:
+// the list's OPEN is consumed alone and a virtual CLOSE is emitted on the other side once the integer has matched.
+std::weak_ordering comparePackets(const std::span<const Token> left, const std::span<const Token> right) {
+    std::size_t leftPos = 0;
+    std::size_t rightPos = 0;
+    int32_t leftPendingCloses = 0;
+    int32_t rightPendingCloses = 0;
+    int32_t leftClosesAfterInt = 0;
+    int32_t rightClosesAfterInt = 0;
+
+    const auto next = [](const std::span<const Token> tokens, const std::size_t pos, const int32_t pendingCloses) {
+        if (pendingCloses > 0) {
+            return CLOSE;
         }
-
-        if (std::holds_alternative<int32_t>(*iter)) {
-            std::cout << std::get<int32_t>(*iter);
+        return pos < tokens.size() ? tokens[pos] : CLOSE;
+    };
+    const auto advance = [](std::size_t& pos, int32_t& pendingCloses) {
+        if (pendingCloses > 0) {
+            --pendingCloses;
         } else {
-            std::cout << std::get<List>(*iter);
+            ++pos;
         }
-    }
-    std::cout << ']';
-    return stream;
-}
+    };
 
-size_t findMatchingClosingBracketPos(const size_t start, const std::string& string) {
-    size_t numberOfOpeningBrackets = 0;
-    size_t numberOfClosingBrackets = 0;
-    for (size_t i = start; i < string.size(); ++i) {
-        const auto c = string.at(i);
-        if (c == '[') {
-            ++numberOfOpeningBrackets;
-        } else if (c == ']') {
-            ++numberOfClosingBrackets;
-        }
+    while (leftPos < left.size() || rightPos < right.size() || leftPendingCloses > 0 || rightPendingCloses > 0) {
+        const auto leftToken = next(left, leftPos, leftPendingCloses);
+        const auto rightToken = next(right, rightPos, rightPendingCloses);
 
-        if (numberOfOpeningBrackets == numberOfClosingBrackets) {
-            return i;
+        if (leftToken == rightToken) {
+            advance(leftPos, leftPendingCloses);
+            advance(rightPos, rightPendingCloses);
+            if (leftToken >= 0) {
+                leftPendingCloses += std::exchange(leftClosesAfterInt, 0);
+                rightPendingCloses += std::exchange(rightClosesAfterInt, 0);
+            }
+        } else if (leftToken == CLOSE) {
+            return std::weak_ordering::less;
+        } else if (rightToken == CLOSE) {
+            return std::weak_ordering::greater;
+        } else if (leftToken == OPEN) {
+            ++rightClosesAfterInt;
+            advance(leftPos, leftPendingCloses);
+        } else if (rightToken == OPEN) {
+            ++leftClosesAfterInt;
+            advance(rightPos, rightPendingCloses);
+        } else {
+            return leftToken <=> rightToken;
         }
     }
-    return std::string::npos;
+    return std::weak_ordering::equivalent;
 }
 
-List parseList(const std::string& string) {
-    List list;
-    for (size_t i = 0U; i < string.size(); ++i) {
-        const auto c = string.at(i);
-        if (c == '[') {
-            const auto closingBracketPos = findMatchingClosingBracketPos(i, string);
-            const auto subLineString = string.substr(i + 1,  closingBracketPos - i - 1);
-            const auto innerList = parseList(subLineString);
-            list.content.emplace_back(innerList);
-            i = closingBracketPos + 1;
-        } else if (c >= '0' && c <= '9') {
-            auto numberSize = 1U;
-            while (i + numberSize < string.size() && string.at(i + numberSize) >= '0' &&
-                    string.at(i + numberSize) <= '9') {
-                ++numberSize;
-            }
-
-            const auto number = std::stol(string.substr(i, numberSize));
-            i += numberSize - 1;
-            list.content.emplace_back(number);
+void printPacket(std::ostream& stream, const std::span<const Token> tokens) {
+    bool needsComma = false;
+    for (const auto token : tokens) {
+        if (token != CLOSE && needsComma) {
+            stream << ',';
         }
+        if (token == OPEN) {
+            stream << '[';
+        } else if (token == CLOSE) {
+            stream << ']';
+        } else {
+            stream << token;
+        }
+        needsComma = token != OPEN;
     }
-
-    return list;
-}
-
-Packet parsePacket(const std::string& line) {
-    return Packet{parseList(line)};
 }
 
 auto parse(const std::filesystem::path& filePath) {
-    static constexpr std::size_t BUFFER_SIZE = 10000;
-
-    std::vector<Packet> packets;
-    packets.reserve(BUFFER_SIZE);
+    Packets packets;
     const auto lineCallback = [&packets](const std::string& line) {
         if (!line.empty()) {
-            packets.push_back(parsePacket(line));
+            packets.add(line);
         }
     };
     parseInput(filePath, lineCallback);
@@ -173,53 +144,50 @@ auto parse(const std::filesystem::path& filePath) {
     return packets;
 }
 
-bool arePacketsInCorrectOrder(const Packet& first, const Packet& second) {
-    return first <= second;
-}
-
-int32_t calculateSumOfCorrectPackets(const std::vector<Packet>& packets, const bool printOutput) {
+int32_t calculateSumOfCorrectPackets(const Packets& packets, const bool printOutput) {
     auto sumOfCorrectPacketsIndices = 0;
-    for (auto index = 0U; index < packets.size() - 1; index += 2) {
-        const auto& first = packets.at(index);
-        const auto& second = packets.at(index + 1);
-        if (arePacketsInCorrectOrder(first, second)) {
-            if (printOutput) {
-                std::cout << "(Y) " << first.items << " vs " << second.items << '\n';
-            }
+    for (std::size_t index = 0; index + 1 < packets.size(); index += 2) {
+        const auto first = packets.at(index);
+        const auto second = packets.at(index + 1);
+        const bool isCorrect = comparePackets(first, second) <= 0;
+        if (isCorrect) {
             sumOfCorrectPacketsIndices += static_cast<int32_t>(index) / 2 + 1;
-        } else {
-            if (printOutput) {
-                std::cout << "(N) " << first.items << " vs " << second.items << '\n';
-            }
+        }
+
+        if (printOutput) {
+            std::cout << (isCorrect ? "(Y) " : "(N) ");
+            printPacket(std::cout, first);
+            std::cout << " vs ";
+            printPacket(std::cout, second);
+            std::cout << '\n';
         }
     }
     return sumOfCorrectPacketsIndices;
 }
 
-int32_t calculateDecoderKey(const std::vector<Packet>& packets, const bool printOutput) {
-    std::vector<Packet> extended = packets;
-    const Packet packet1 = parsePacket("[[2]]");
-    const Packet packet2 = parsePacket("[[6]]");
-    extended.push_back(packet1);
-    extended.push_back(packet2);
-
-    std::sort(extended.begin(), extended.end());
-    size_t index1 = 0;
-    size_t index2 = 0;
-
-    for (auto i = 0U; i < extended.size(); ++i) {
-        if (extended.at(i) == packet1) {
-            index1 = i + 1;
-        }
-        if (extended.at(i) == packet2) {
-            index2 = i + 1;
+// The divider positions in the sorted list follow from how many packets order before each divider, so no sort is
+// needed. "[[2]]" itself orders before "[[6]]".
+int64_t calculateDecoderKey(const Packets& packets, const bool printOutput) {
+    Packets dividers;
+    dividers.add("[[2]]");
+    dividers.add("[[6]]");
+
+    int64_t index1 = 1;
+    int64_t index2 = 2;
+    for (std::size_t i = 0; i < packets.size(); ++i) {
+        const auto packet = packets.at(i);
+        if (comparePackets(packet, dividers.at(0)) < 0) {
+            ++index1;
+            ++index2;
+        } else if (comparePackets(packet, dividers.at(1)) < 0) {
+            ++index2;
         }
+    }
 
-        if (printOutput) {
-            std::cout << extended.at(i).items << '\n';
-        }
+    if (printOutput) {
+        std::cout << "[[2]] at " << index1 << ", [[6]] at " << index2 << '\n';
     }
-    return static_cast<int32_t>(index1 * index2);
+    return index1 * index2;
 }
 }  // namespace
 
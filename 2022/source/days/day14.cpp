@@ -5,6 +5,7 @@
 #include "bblp/aoc/grid.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
@@ -71,21 +72,15 @@ auto parse(const std::filesystem::path& filePath) {
     return input;
 }
 
-void printDelimiter(std::ostream& stream, const int32_t step) {
-    stream << "========== " << std::setw(4) << step << " ==========" << '\n';
-}
-
-void printGrid(std::ostream& stream, const Grid<char>& grid, const Point& offset, const Point& size) {
-    for (auto y = 0; y < size.y; ++y) {
-        for (auto x = 0; x < size.x; ++x) {
-            stream << grid.at(offset.x + x, offset.y + y);
+void printGrid(std::ostream& stream, const Grid<char>& grid) {
+    for (auto y = 0; y < grid.height(); ++y) {
+        for (auto x = 0; x < grid.width(); ++x) {
+            stream << grid.at(x, y);
         }
         stream << '\n';
     }
 }
 
-constexpr int32_t GRID_WIDTH = 1000;
-constexpr int32_t GRID_HEIGHT = 1000;
 constexpr Point SAND_START(500, 0);
 
 constexpr char TILE_AIR = '.';
@@ -93,99 +88,133 @@ constexpr char TILE_ROCK = '#';
 constexpr char TILE_SAND = 'o';
 constexpr char TILE_SPAWN = '+';
 
-void markInitial(Grid<char>& grid, const std::vector<Line>& lines) {
+// Cave tiles cropped to the rocks and to the widest pile the floor can hold. Columns are shifted by `minX`; the
+// last row is where the floor of part two lies.
+struct Cave {
+    [[nodiscard]] char at(const int64_t x, const int64_t y) const { return tiles.at(x - minX, y); }
+    [[nodiscard]] char& at(const int64_t x, const int64_t y) { return tiles.at(x - minX, y); }
+
+    Grid<char> tiles;
+    int64_t minX;
+    int64_t lowestRockY;
+};
+
+Cave buildCave(const std::vector<Line>& lines) {
+    int64_t minX = SAND_START.x;
+    int64_t maxX = SAND_START.x;
+    int64_t lowestRockY = SAND_START.y;
+    for (const auto& line : lines) {
+        minX = std::min(minX, line.start.x);
+        maxX = std::max(maxX, line.end.x);
+        lowestRockY = std::max(lowestRockY, line.end.y);
+    }
+
+    const auto floorY = lowestRockY + 2;
+    minX = std::min(minX, SAND_START.x - floorY) - 1;
+    maxX = std::max(maxX, SAND_START.x + floorY) + 1;
+
+    Cave cave{Grid<char>(maxX - minX + 1, floorY + 1, TILE_AIR), minX, lowestRockY};
     for (const auto& line : lines) {
         if (line.isHorizontal()) {
             for (auto x = 0; x < line.horizontalLength(); ++x) {
-                grid.at(line.start.x + x, line.start.y) = TILE_ROCK;
+                cave.at(line.start.x + x, line.start.y) = TILE_ROCK;
             }
         } else if (line.isVertical()) {
             for (auto y = 0; y < line.verticalLength(); ++y) {
-                grid.at(line.start.x, line.start.y + y) = TILE_ROCK;
+                cave.at(line.start.x, line.start.y + y) = TILE_ROCK;
             }
         }
     }
-    grid.at(SAND_START) = TILE_SPAWN;
+    cave.at(SAND_START.x, SAND_START.y) = TILE_SPAWN;
+    return cave;
 }
 
-int32_t simulate(Grid<char>& grid) {
-    int32_t numberOfSandSpawned = 0;
-    Point sand = SAND_START;
-    while (sand.y < grid.height() - 1) {
-        if (sand == SAND_START) {
-            ++numberOfSandSpawned;
+// Drops grains until one falls past the lowest rock. The path of the falling grain is kept on a stack: when it
+// comes to rest, the next grain follows the same path and resumes from the cell just above.
+int32_t simulate(Cave& cave) {
+    static constexpr std::array<int64_t, 3> FALL_OFFSETS{0, -1, 1};
+
+    int32_t numberOfSandAtRest = 0;
+    std::vector<Point> path{SAND_START};
+    while (!path.empty()) {
+        const auto sand = path.back();
+        if (sand.y > cave.lowestRockY) {
+            break;
         }
 
-        if (grid.at(sand.x, sand.y + 1) == TILE_AIR) {
-            grid.at(sand) = TILE_AIR;
-            sand.y++;
-            grid.at(sand) = TILE_SAND;
+        const auto next = std::find_if(FALL_OFFSETS.cbegin(), FALL_OFFSETS.cend(), [&cave, &sand](const int64_t dx) {
+            return cave.at(sand.x + dx, sand.y + 1) == TILE_AIR;
+        });
+        if (next != FALL_OFFSETS.cend()) {
+            path.emplace_back(sand.x + *next, sand.y + 1);
         } else {
-            if (grid.at(sand.x - 1, sand.y + 1) == TILE_AIR) {
-                grid.at(sand) = TILE_AIR;
-                sand.x--;
-                sand.y++;
-                grid.at(sand) = TILE_SAND;
-            } else if (grid.at(sand.x + 1, sand.y + 1) == TILE_AIR) {
-                grid.at(sand) = TILE_AIR;
-                sand.x++;
-                sand.y++;
-                grid.at(sand) = TILE_SAND;
-            } else {
-                if (sand == SAND_START) {
-                    grid.at(sand) = TILE_SAND;
-                    break;
-                } else  {
-                    grid.at(sand) = TILE_SAND;
-                    sand = SAND_START;
-                }
+            cave.at(sand.x, sand.y) = TILE_SAND;
+            ++numberOfSandAtRest;
+            path.pop_back();
+        }
+    }
+    return numberOfSandAtRest;
+}
+
+// With a floor every grain ends up somewhere, so the final pile is exactly the set of cells reachable from the
+// spawn. A cell is reached when it is not rock and one of the three cells above it was reached.
+int32_t fillAboveFloor(Cave& cave) {
+    const auto floorY = cave.tiles.height() - 1;
+
+    int32_t numberOfSandAtRest = 0;
+    for (int64_t y = SAND_START.y; y < floorY; ++y) {
+        const auto reach = y - SAND_START.y;
+        for (auto x = SAND_START.x - reach; x <= SAND_START.x + reach; ++x) {
+            if (cave.at(x, y) == TILE_ROCK) {
+                continue;
+            }
+
+            const bool isReached = y == SAND_START.y || cave.at(x - 1, y - 1) == TILE_SAND ||
+                                   cave.at(x, y - 1) == TILE_SAND || cave.at(x + 1, y - 1) == TILE_SAND;
+            if (isReached) {
+                cave.at(x, y) = TILE_SAND;
+                ++numberOfSandAtRest;
             }
         }
     }
-    return numberOfSandSpawned;
+    for (int64_t x = 0; x < cave.tiles.width(); ++x) {
+        cave.tiles.at(x, floorY) = TILE_ROCK;
+    }
+    return numberOfSandAtRest;
 }
 
-void saveToFile(const Grid<char>& grid, const std::filesystem::path& fileName) {
+void saveToFile(const Cave& cave, const std::filesystem::path& fileName) {
     std::ofstream output(fileName);
-    printGrid(output, grid, Point(0, 0), Point(GRID_WIDTH, GRID_HEIGHT));
+    printGrid(output, cave.tiles);
 }
 
-int32_t calculatePart1(const std::vector<Line>& lines) {
-
-    Grid<char> grid(GRID_WIDTH, GRID_HEIGHT, TILE_AIR);
-    markInitial(grid, lines);
+int32_t calculatePart1(const std::vector<Line>& lines, const bool saveOutput) {
+    auto cave = buildCave(lines);
+    const auto numberOfSandAtRest = simulate(cave);
 
-    const auto numberOfSandSpawned = simulate(grid);
-
-    saveToFile(grid, "resources/day14_1.txt");
+    if (saveOutput) {
+        saveToFile(cave, "resources/day14_1.txt");
+    }
 
-    return numberOfSandSpawned - 1;
+    return numberOfSandAtRest;
 }
 
-int32_t calculatePart2(const std::vector<Line>& lines) {
-    Grid<char> grid(GRID_WIDTH, GRID_HEIGHT, TILE_AIR);
-    markInitial(grid, lines);
-
-    const auto maxIter = std::max_element(lines.cbegin(), lines.cend(), [](const Line& lhs, const Line& rhs) {
-        return (lhs.end.y < rhs.end.y);
-    });
+int32_t calculatePart2(const std::vector<Line>& lines, const bool saveOutput) {
+    auto cave = buildCave(lines);
+    const auto numberOfSandAtRest = fillAboveFloor(cave);
 
-    for (auto x = 0; x < grid.width(); ++x) {
-        grid.at(x, maxIter->end.y + 2) = TILE_ROCK;
+    if (saveOutput) {
+        saveToFile(cave, "resources/day14_2.txt");
     }
 
-    const auto numberOfSandSpawned = simulate(grid);
-
-    saveToFile(grid, "resources/day14_2.txt");
-
-    return numberOfSandSpawned;
+    return numberOfSandAtRest;
 }
 }  // namespace
 
-std::pair<std::string, std::string> day14() {
+std::pair<std::string, std::string> day14(const bool saveOutput) {
     const auto input = parse("resources/day14.txt");
-    const auto spawnedSandPart1 = calculatePart1(input);
-    const auto spawnedSandPart2 = calculatePart2(input);
+    const auto spawnedSandPart1 = calculatePart1(input, saveOutput);
+    const auto spawnedSandPart2 = calculatePart2(input, saveOutput);
 
     return {std::to_string(spawnedSandPart1), std::to_string(spawnedSandPart2)};
 }
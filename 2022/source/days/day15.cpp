@@ -7,22 +7,30 @@
 #include <algorithm>
 #include <cstdlib>
 #include <numeric>
+#include <optional>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
-constexpr int64_t MIN = 0;
-constexpr int64_t MAX = 4000000;
+constexpr int64_t TARGET_ROW = 2000000;
+constexpr int64_t SEARCH_MAX = 4000000;
 constexpr int64_t FREQUENCY_MUL = 4000000;
 constexpr int64_t INVALID_REQUENCY = -1;
 
-bool operator<(const Point& lhs, const Point& rhs) {
-    return lhs.x < rhs.x;
-}
+struct Sensor {
+    Point position;
+    Point beacon;
+    int64_t radius;
+};
+
+// Closed range of x coordinates [begin, end].
+struct Interval {
+    int64_t begin;
+    int64_t end;
+};
 
-std::ostream& operator<<(std::ostream& stream, const Point& point) {
-    stream << "x=" << point.x << ";y=" << point.y;
-    return stream;
+int64_t calculateDistance(const Point& from, const Point& to) {
+    return std::abs(from.x - to.x) + std::abs(from.y - to.y);
 }
 
 Point parsePoint(const std::string& string) {
@@ -33,9 +41,9 @@ Point parsePoint(const std::string& string) {
 }
 
 auto parse(const std::filesystem::path& filePath) {
-    static constexpr std::size_t BUFFER_SIZE = 10;
+    static constexpr std::size_t BUFFER_SIZE = 32;
 
-    std::vector<std::pair<Point, Point>> input;
+    std::vector<Sensor> input;
     input.reserve(BUFFER_SIZE);
     const auto lineCallback = [&input](const std::string& line) {
         if (line.empty()) {
@@ -43,186 +51,130 @@ auto parse(const std::filesystem::path& filePath) {
         }
 
         const auto items = split(line, ":");
-        input.emplace_back(parsePoint(items[0]), parsePoint(items[1]));
+        const auto position = parsePoint(items[0]);
+        const auto beacon = parsePoint(items[1]);
+        input.push_back({position, beacon, calculateDistance(position, beacon)});
     };
     parseInput(filePath, lineCallback);
     return input;
 }
 
-int64_t calculateDistance(const Point& from, const Point& to) {
-    return std::abs(from.x - to.x) + std::abs(from.y - to.y);
-}
-
-bool isInRangeOfSensor(const Point& target, const Point& sensor, const Point& beacon) {
-    return (calculateDistance(target, sensor) <= calculateDistance(beacon, sensor));
-}
-
-int64_t minLeft(const Point& sensor, const Point& beacon) {
-    return sensor.x - std::abs(beacon.x);
-}
-
-int64_t maxRight(const Point& sensor, const Point& beacon) {
-    return sensor.x + std::abs(beacon.x);
-}
-
-int64_t calculateNumberOfInvalidPositions(const std::vector<std::pair<Point, Point>>& input) {
-    const auto minIter = std::min_element(input.cbegin(), input.cend(), [](const auto& lhs, const auto& rhs) {
-        return minLeft(lhs.first, lhs.second) < minLeft(rhs.first, rhs.second);
-    });
-
-    const auto maxIter = std::max_element(input.cbegin(), input.cend(), [](const auto& lhs, const auto& rhs) {
-        return maxRight(lhs.first, lhs.second) < maxRight(rhs.first, rhs.second);
-    });
-
-    const auto minX = minLeft(minIter->first, minIter->second);
-    const auto maxX = maxRight(maxIter->first, maxIter->second);
-
-    const int64_t targetRow = 2000000;
-    int32_t numberOfInvalidPositions = 0;
-    for (int64_t x = minX; x <= maxX; ++x) {
-        const Point target(x, targetRow);
-        for (const auto& pair : input) {
-            if (target == pair.first || target == pair.second) {
-                continue;
-            }
-            if (isInRangeOfSensor(target, pair.first, pair.second)) {
-                ++numberOfInvalidPositions;
-                break;
-            }
-        }
-    }
-    return numberOfInvalidPositions;
-}
-
-bool isInRangeOfOtherSensors(const Point& target,
-                             const std::vector<std::pair<Point, Point>>& input) {
-
-    return std::any_of(input.cbegin(), input.cend(), [&target](const std::pair<Point, Point>& pair) {
-        return isInRangeOfSensor(target, pair.first, pair.second);
+bool isInRangeOfAnySensor(const Point& target, const std::vector<Sensor>& sensors) {
+    return std::any_of(sensors.cbegin(), sensors.cend(), [&target](const Sensor& sensor) {
+        return calculateDistance(target, sensor.position) <= sensor.radius;
     });
 }
 
-bool isPointValid(const Point& point) {
-    return point.x >= MIN && point.x <= MAX && point.y >= MIN && point.y <= MAX;
-}
-
-bool checkPoint(const Point& point, const std::vector<std::pair<Point, Point>>& input) {
-    if (isPointValid(point)) {
-        if (!isInRangeOfOtherSensors(point, input)) {
-            return false;
+// Sorted, disjoint and non-adjacent intervals covered by the sensors on one row. `intervals` is scratch space
+// reused between calls.
+void collectCoverage(const std::vector<Sensor>& sensors, const int64_t row, std::vector<Interval>& intervals) {
+    intervals.clear();
+    for (const auto& sensor : sensors) {
+        const auto reach = sensor.radius - std::abs(sensor.position.y - row);
+        if (reach >= 0) {
+            intervals.push_back({sensor.position.x - reach, sensor.position.x + reach});
         }
     }
-    return true;
-}
-
-int64_t checkTopLeftDiagonal(const Point& sensor,
-                             const int64_t distance,
-                             const std::vector<std::pair<Point, Point>>& input) {
-    int64_t x = sensor.x - distance;
-    int64_t y = sensor.y;
-    while (x <= sensor.x && y >= sensor.y - distance) {
-        if (!checkPoint(Point(x, y), input)) {
-            return x * FREQUENCY_MUL + y;
+    std::sort(intervals.begin(), intervals.end(),
+              [](const Interval& lhs, const Interval& rhs) { return lhs.begin < rhs.begin; });
+
+    std::size_t merged = 0;
+    for (std::size_t i = 1; i < intervals.size(); ++i) {
+        if (intervals[i].begin <= intervals[merged].end + 1) {
+            intervals[merged].end = std::max(intervals[merged].end, intervals[i].end);
+        } else {
+            intervals[++merged] = intervals[i];
         }
-        ++x;
-        --y;
     }
-    return INVALID_REQUENCY;
+    intervals.resize(std::min(intervals.size(), merged + 1));
 }
 
-int64_t checkTopRightDiagonal(const Point& sensor,
-                              const int64_t distance,
-                              const std::vector<std::pair<Point, Point>>& input) {
-    int64_t x = sensor.x + distance;
-    int64_t y = sensor.y;
-    while (x >= sensor.x && y <= sensor.y + distance) {
-        if (!checkPoint(Point(x, y), input)) {
-            return x * FREQUENCY_MUL + y;
-        }
+int64_t calculateNumberOfInvalidPositions(const std::vector<Sensor>& sensors, const int64_t targetRow) {
+    std::vector<Interval> intervals;
+    collectCoverage(sensors, targetRow, intervals);
 
-        --x;
-        ++y;
-    }
-    return INVALID_REQUENCY;
-}
+    int64_t numberOfInvalidPositions = std::accumulate(
+        intervals.cbegin(), intervals.cend(), int64_t{0},
+        [](const int64_t sum, const Interval& interval) { return sum + interval.end - interval.begin + 1; });
 
-int64_t checkBottomLeftDiagonal(const Point& sensor,
-                                const int64_t distance,
-                                const std::vector<std::pair<Point, Point>>& input) {
-    int64_t x = sensor.x - distance;
-    int64_t y = sensor.y;
-    while (x <= sensor.x && y <= sensor.y + distance) {
-        if (!checkPoint(Point(x, y), input)) {
-            return x * FREQUENCY_MUL + y;
+    // Sensors and beacons always lie inside their own range, so every distinct one on the row was counted above.
+    std::vector<int64_t> occupied;
+    for (const auto& sensor : sensors) {
+        for (const auto& point : {sensor.position, sensor.beacon}) {
+            if (point.y == targetRow) {
+                occupied.push_back(point.x);
+            }
         }
-        ++x;
-        ++y;
     }
-    return INVALID_REQUENCY;
+    std::sort(occupied.begin(), occupied.end());
+    numberOfInvalidPositions -= std::distance(occupied.begin(), std::unique(occupied.begin(), occupied.end()));
+    return numberOfInvalidPositions;
 }
 
-int64_t checkBottomRightDiagonal(const Point& sensor,
-                                 const int64_t distance,
-                                 const std::vector<std::pair<Point, Point>>& input) {
-    int64_t x = sensor.x + distance;
-    int64_t y = sensor.y;
-    while (x >= sensor.x && y >= sensor.y - distance) {
-        if (!checkPoint(Point(x, y), input)) {
-            return x * FREQUENCY_MUL + y;
-        }
-        --x;
-        --y;
+// A lone uncovered cell inside the search area is bordered by sensor ranges on all sides, so it sits on the
+// intersection of a rising and a falling diamond edge just outside some sensors. In rotated coordinates
+// (u = x + y, v = x - y) those edges are the lines u = c ± (r + 1) and v = d ± (r + 1).
+std::optional<Point> findGapOnDiamondEdges(const std::vector<Sensor>& sensors, const int64_t searchMax) {
+    std::vector<int64_t> risingEdges;
+    std::vector<int64_t> fallingEdges;
+    for (const auto& sensor : sensors) {
+        const auto u = sensor.position.x + sensor.position.y;
+        const auto v = sensor.position.x - sensor.position.y;
+        risingEdges.insert(risingEdges.end(), {u - sensor.radius - 1, u + sensor.radius + 1});
+        fallingEdges.insert(fallingEdges.end(), {v - sensor.radius - 1, v + sensor.radius + 1});
     }
-    return INVALID_REQUENCY;
-}
-
-int64_t calculateTuningFrequency(const std::vector<std::pair<Point, Point>>& input) {
-    for (const auto& pair : input) {
-        const auto& sensor = pair.first;
-        const auto& beacon = pair.second;
-        const auto distance = calculateDistance(sensor, beacon);
 
-        if (const auto result = checkTopLeftDiagonal(sensor, distance + 1, input); result != INVALID_REQUENCY) {
-            return result;
-        }
-
-        if (const auto result = checkTopLeftDiagonal(sensor, distance + 2, input); result != INVALID_REQUENCY) {
-            return result;
-        }
-
-        if (const auto result = checkTopRightDiagonal(sensor, distance + 1, input); result != INVALID_REQUENCY) {
-            return result;
-        }
+    for (const auto u : risingEdges) {
+        for (const auto v : fallingEdges) {
+            if (((u - v) & 1) != 0) {
+                continue;
+            }
 
-        if (const auto result = checkTopRightDiagonal(sensor, distance + 2, input); result != INVALID_REQUENCY) {
-            return result;
+            const Point candidate((u + v) / 2, (u - v) / 2);
+            if (candidate.x >= 0 && candidate.x <= searchMax && candidate.y >= 0 && candidate.y <= searchMax &&
+                !isInRangeOfAnySensor(candidate, sensors)) {
+                return candidate;
+            }
         }
+    }
+    return std::nullopt;
+}
 
-        if (const auto result = checkBottomLeftDiagonal(sensor, distance + 1, input); result != INVALID_REQUENCY) {
-            return result;
-        }
+// Fallback for gaps pinned against the search border, where fewer diamond edges meet: scan each row's merged
+// coverage and jump straight past every interval.
+std::optional<Point> findGapByRowScan(const std::vector<Sensor>& sensors, const int64_t searchMax) {
+    std::vector<Interval> intervals;
+    for (int64_t y = 0; y <= searchMax; ++y) {
+        collectCoverage(sensors, y, intervals);
 
-        if (const auto result = checkBottomLeftDiagonal(sensor, distance + 2, input); result != INVALID_REQUENCY) {
-            return result;
+        int64_t x = 0;
+        for (const auto& interval : intervals) {
+            if (interval.begin > x) {
+                break;
+            }
+            x = std::max(x, interval.end + 1);
         }
-
-        if (const auto result = checkBottomRightDiagonal(sensor, distance + 1, input); result != INVALID_REQUENCY) {
-            return result;
+        if (x <= searchMax) {
+            return Point(x, y);
         }
+    }
+    return std::nullopt;
+}
 
-        if (const auto result = checkBottomRightDiagonal(sensor, distance + 2, input); result != INVALID_REQUENCY) {
-            return result;
-        }
+int64_t calculateTuningFrequency(const std::vector<Sensor>& sensors, const int64_t searchMax) {
+    auto gap = findGapOnDiamondEdges(sensors, searchMax);
+    if (!gap.has_value()) {
+        gap = findGapByRowScan(sensors, searchMax);
     }
-    return INVALID_REQUENCY;
+    return gap.has_value() ? gap->x * FREQUENCY_MUL + gap->y : INVALID_REQUENCY;
 }
 }  // namespace
 
 std::pair<std::string, std::string> day15() {
     const auto input = parse("resources/day15.txt");
 
-    const auto numberOfInvalidPositions = calculateNumberOfInvalidPositions(input);
-    const auto tuningFrequency = calculateTuningFrequency(input);
+    const auto numberOfInvalidPositions = calculateNumberOfInvalidPositions(input, TARGET_ROW);
+    const auto tuningFrequency = calculateTuningFrequency(input, SEARCH_MAX);
 
     return {std::to_string(numberOfInvalidPositions), std::to_string(tuningFrequency)};
 }
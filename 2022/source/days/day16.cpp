@@ -4,150 +4,45 @@
 #include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
-#include <fstream>
-#include <iostream>
-#include <numeric>
-#include <queue>
-#include <stack>
-#include <set>
+#include <limits>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
+namespace bblp::aoc {
+namespace {
 using FlowRate = int32_t;
 
-struct Node {
-    constexpr auto operator<=>(const Node& other) const noexcept { return label <=> other.label; }
+constexpr int32_t MINUTES_ALONE = 30;
+constexpr int32_t MINUTES_WITH_ELEPHANT = 26;
+constexpr int32_t UNREACHABLE = std::numeric_limits<int32_t>::max() / 2;
+constexpr std::size_t MAX_USEFUL_VALVES = 24U;
+const std::string START_LABEL{"AA"};
 
+struct Valve {
     std::string label;
     FlowRate flowRate;
-    std::vector<std::string> connectionsLabels;
-    std::vector<Node*> connections;
-    std::unordered_map<Node*, std::vector<Node*>> paths;
-};
-
-class Graph {
-  public:
-    void buildConnections();
-    void buildShortestPaths();
-    std::vector<Node*> findShortestPath(Node& start, Node& end);
-
-    Node* findNode(const std::string& label);
-    const Node* findNode(const std::string& label) const;
-
-    int32_t calcValveScore(const Node& currentNode, const Node& target) {}
-
-    std::vector<std::unique_ptr<Node>> nodes;
-
-  private:
+    std::vector<std::string> tunnels;
 };
 
-void Graph::buildConnections() {
-    for (auto& node : nodes) {
-        for (const auto& label : node->connectionsLabels) {
-            auto foundNode = findNode(label);
-            if (foundNode != nullptr) {
-                node->connections.emplace_back(foundNode);
-            }
-        }
-    }
-}
-
-void Graph::buildShortestPaths() {
-    for (auto& start : nodes) {
-        for (auto& end : nodes) {
-            if (start.get() == end.get()) {
-                continue;
-            }
-
-            start->paths[end.get()] = findShortestPath(*start, *end);
-        }
-    }
-}
-
-Node* Graph::findNode(const std::string& label) {
-    const auto iter =
-        std::find_if(nodes.begin(), nodes.end(), [&label](const auto& node) { return node->label == label; });
-    return (iter != nodes.end() ? iter->get() : nullptr);
-}
-
-const Node* Graph::findNode(const std::string& label) const {
-    const auto iter =
-        std::find_if(nodes.begin(), nodes.end(), [&label](const auto& node) { return node->label == label; });
-    return (iter != nodes.end() ? iter->get() : nullptr);
-}
-
-std::vector<Node*> Graph::findShortestPath(Node& start, Node& end) {
-    using p = std::pair<int32_t, const Node*>;
-
-    std::unordered_map<Node*, bool> visited;
-    std::unordered_map<Node*, int32_t> distances;
-    std::unordered_map<Node*, Node*> parents;
-    for (const auto& node : nodes) {
-        visited[node.get()] = false;
-        distances[node.get()] = INT32_MAX;
-        parents[node.get()] = nullptr;
-    }
-    distances[&start] = 0;
-    parents[&start] = nullptr;
-
-    std::list<Node*> queue;
-    queue.push_back(&start);
-
-    while (!queue.empty()) {
-        Node* currentNode = queue.front();
-        queue.pop_front();
-
-        for (auto& connection : currentNode->connections) {
-            if (visited[connection]) {
-                continue;
-            }
-
-            visited[connection] = true;
-            distances[connection] = distances[currentNode];
-            parents[connection] = currentNode;
-            queue.push_back(connection);
-
-            if (connection == &end) {
-                queue.clear();
-                break;
-            }
-        }
-    }
-
-    std::vector<Node*> path;
-    Node* currentNode = &end;
-    path.emplace_back(currentNode);
-    while (currentNode != &start) {
-        Node* parent = parents[currentNode];
-        path.push_back(parent);
-        currentNode = parent;
-    }
-
-    std::reverse(path.begin(), path.end());
-    return path;
-}
-
-namespace bblp::aoc {
-namespace {
-
-constexpr int32_t MINUTES = 30;
-
 std::vector<std::string> parseConnections(const std::string& string) {
-    static constexpr std::string_view VALVE = "valve";
-
-    auto valvePos = string.find_last_of("valve");
-    if (string.at(valvePos + 1) == 's') {
+    auto valvePos = string.find("valve");
+    if (valvePos == std::string::npos) {
+        throw std::logic_error("Invalid line format");
+    }
+    valvePos += std::string_view{"valve"}.size();
+    if (string.at(valvePos) == 's') {
         ++valvePos;
     }
 
-    return split(string.substr(valvePos + 2), ", ");
+    return split(string.substr(valvePos + 1), ", ");
 }
 
 auto parse(const std::filesystem::path& filePath) {
-    static constexpr std::size_t BUFFER_SIZE = 10000;
-
-    Graph input;
+    std::vector<Valve> input;
     const auto lineCallback = [&input](const std::string& line) {
         if (line.empty()) {
             return;
@@ -158,80 +53,149 @@ auto parse(const std::filesystem::path& filePath) {
 
         const auto label = parts[0].substr(6, 2);
         const auto flowRate = std::stol(parts[0].substr(equalPos + 1));
-        const auto connections = parseConnections(parts[1]);
-
-        input.nodes.emplace_back(std::make_unique<Node>(label, flowRate, connections));
+        input.push_back(Valve{label, static_cast<FlowRate>(flowRate), parseConnections(parts[1])});
     };
     parseInput(filePath, lineCallback);
-    input.buildConnections();
-    input.buildShortestPaths();
     return input;
 }
 
-struct Evalution {
-    constexpr auto operator<=>(const Evalution& other) noexcept { return value <=> other.value; }
+// Only the valves worth opening remain, plus the start as the last index. Moving between any two of them takes
+// the all-pairs shortest distance of the full tunnel graph.
+struct ValveNetwork {
+    std::vector<FlowRate> flowRates;
+    std::size_t start;
+    std::vector<int32_t> distances;
 
-    Node* node;
-    int32_t value;
-};
-
-struct Step {
-    Step(const Node* node, std::vector<Evalution> unvisited) : node(node), unvisited(std::move(unvisited)) {}
-
-    const Node* node;
-    std::vector<Evalution> unvisited;
+    [[nodiscard]] int32_t distance(const std::size_t from, const std::size_t to) const {
+        return distances[from * (flowRates.size() + 1U) + to];
+    }
 };
 
-int32_t evaluateAtDepth(const Graph& graph, std::set<const Node*>& opened, const Node* currentNode, const int32_t currentMinute) {
-    const auto timeLeft = MINUTES - currentMinute;
-    int32_t bestScore = 0;
+ValveNetwork compressNetwork(const std::vector<Valve>& valves) {
+    const auto count = valves.size();
+    std::unordered_map<std::string, std::size_t> indexOfLabel;
+    for (std::size_t i = 0U; i < count; ++i) {
+        indexOfLabel.emplace(valves[i].label, i);
+    }
+    const auto startIter = indexOfLabel.find(START_LABEL);
+    if (startIter == indexOfLabel.end()) {
+        throw std::logic_error("Start valve not found");
+    }
 
-    std::vector<Evalution> evaluations;
-    evaluations.reserve(graph.nodes.size() - 1);
+    // Floyd-Warshall over the full graph.
+    std::vector<int32_t> allDistances(count * count, UNREACHABLE);
+    for (std::size_t i = 0U; i < count; ++i) {
+        allDistances[i * count + i] = 0;
+        for (const auto& tunnel : valves[i].tunnels) {
+            const auto target = indexOfLabel.find(tunnel);
+            if (target != indexOfLabel.end()) {
+                allDistances[i * count + target->second] = 1;
+            }
+        }
+    }
+    for (std::size_t k = 0U; k < count; ++k) {
+        for (std::size_t i = 0U; i < count; ++i) {
+            for (std::size_t j = 0U; j < count; ++j) {
+                allDistances[i * count + j] =
+                    std::min(allDistances[i * count + j], allDistances[i * count + k] + allDistances[k * count + j]);
+            }
+        }
+    }
 
-    for (const auto& path : currentNode->paths) {
-        const auto distance = path.second.size() - 1;
-        const auto score = path.first->flowRate * (timeLeft - distance - 1);
+    std::vector<std::size_t> kept;
+    for (std::size_t i = 0U; i < count; ++i) {
+        if (valves[i].flowRate > 0) {
+            kept.push_back(i);
+        }
+    }
+    if (kept.size() > MAX_USEFUL_VALVES) {
+        throw std::out_of_range("Too many valves with non-zero flow rate");
+    }
+    kept.push_back(startIter->second);
 
-        const auto iter = opened.find(path.first);
-        if (iter == opened.end() && score != 0) {
-            const auto& eval = evaluations.emplace_back(path.first, score);
+    ValveNetwork network{{}, kept.size() - 1U, std::vector<int32_t>(kept.size() * kept.size())};
+    for (std::size_t i = 0U; i + 1U < kept.size(); ++i) {
+        network.flowRates.push_back(valves[kept[i]].flowRate);
+    }
+    for (std::size_t i = 0U; i < kept.size(); ++i) {
+        for (std::size_t j = 0U; j < kept.size(); ++j) {
+            network.distances[i * kept.size() + j] = allDistances[kept[i] * count + kept[j]];
         }
     }
+    return network;
+}
 
-    for (const auto& eval : evaluations) {
-        int32_t evalScore = 0;
-        const auto& path = currentNode->paths.at(eval.node);
-        const auto distance = path.size() - 1;
-        if (distance <= timeLeft - 1) {
-            opened.insert(eval.node);
-            const int32_t evalScore = eval.value + evaluateAtDepth(graph, opened, eval.node, currentMinute + distance + 1);
-            opened.erase(eval.node);
-
-            if (bestScore < evalScore) {
-                bestScore = evalScore;
-            }
+// Visits every order in which valves can still be opened in time and records, for each set of opened valves, the
+// most pressure any such order releases. `bestOnArrival` remembers the most pressure seen on reaching each
+// (valve, time left, opened set); arriving there again with no more pressure cannot improve any set, so that branch
+// is cut.
+void collectBestPressures(const ValveNetwork& network,
+                          const std::size_t valve,
+                          const int32_t timeLeft,
+                          const uint32_t opened,
+                          const int32_t pressure,
+                          std::vector<int32_t>& bestPressure,
+                          std::unordered_map<uint64_t, int32_t>& bestOnArrival) {
+    const auto state = (static_cast<uint64_t>(opened) << 16U) | (static_cast<uint64_t>(valve) << 8U) |
+                       static_cast<uint64_t>(timeLeft);
+    const auto [iter, inserted] = bestOnArrival.try_emplace(state, pressure);
+    if (!inserted) {
+        if (iter->second >= pressure) {
+            return;
         }
+        iter->second = pressure;
     }
 
-    return bestScore;
+    bestPressure[opened] = std::max(bestPressure[opened], pressure);
+    for (std::size_t next = 0U; next < network.flowRates.size(); ++next) {
+        const auto bit = 1U << next;
+        const auto timeLeftAfterOpening = timeLeft - network.distance(valve, next) - 1;
+        if ((opened & bit) != 0U || timeLeftAfterOpening <= 0) {
+            continue;
+        }
+
+        collectBestPressures(network, next, timeLeftAfterOpening, opened | bit,
+                             pressure + timeLeftAfterOpening * network.flowRates[next], bestPressure, bestOnArrival);
+    }
 }
 
-int32_t findMaxPossiblePressure(const Graph& graph) {
-    const Node* startingNode = graph.findNode("AA");
+std::vector<int32_t> findBestPressurePerValveSet(const ValveNetwork& network, const int32_t minutes) {
+    std::vector<int32_t> bestPressure(std::size_t{1U} << network.flowRates.size(), 0);
+    std::unordered_map<uint64_t, int32_t> bestOnArrival;
+    collectBestPressures(network, network.start, minutes, 0U, 0, bestPressure, bestOnArrival);
+    return bestPressure;
+}
 
+int32_t findMaxPressureAlone(const ValveNetwork& network) {
+    const auto bestPressure = findBestPressurePerValveSet(network, MINUTES_ALONE);
+    return *std::max_element(bestPressure.cbegin(), bestPressure.cend());
+}
 
-    std::set<const Node*> opened;
-    int32_t currentMinute = 0;
-    int32_t totalScore = 0;
+// Both agents open disjoint sets of valves, so the answer is the best pair of complementary sets once every entry
+// holds the best pressure over all of its subsets.
+int32_t findMaxPressureWithElephant(const ValveNetwork& network) {
+    auto bestPressure = findBestPressurePerValveSet(network, MINUTES_WITH_ELEPHANT);
+    const auto setCount = bestPressure.size();
+    for (std::size_t bit = 1U; bit < setCount; bit <<= 1U) {
+        for (std::size_t set = 0U; set < setCount; ++set) {
+            if ((set & bit) != 0U) {
+                bestPressure[set] = std::max(bestPressure[set], bestPressure[set ^ bit]);
+            }
+        }
+    }
 
-    return evaluateAtDepth(graph, opened, startingNode, 0);
+    const auto allValves = setCount - 1U;
+    int32_t result{0};
+    for (std::size_t set = 0U; set < setCount; ++set) {
+        result = std::max(result, bestPressure[set] + bestPressure[allValves ^ set]);
+    }
+    return result;
 }
 }  // namespace
 
 std::pair<std::string, std::string> day16() {
     const auto input = parse("resources/day16.txt");
-    const auto pressure = findMaxPossiblePressure(input);
-    return {std::to_string(pressure), ""};
+    const auto network = compressNetwork(input);
+    return {std::to_string(findMaxPressureAlone(network)), std::to_string(findMaxPressureWithElephant(network))};
 }
 }  // namespace bblp::aoc
@@ -18,7 +18,7 @@ std::pair<std::string, std::string> day10(bool printOutput = true);
 std::pair<std::string, std::string> day11();
 std::pair<std::string, std::string> day12();
 std::pair<std::string, std::string> day13(bool printOutput = true);
-std::pair<std::string, std::string> day14();
+std::pair<std::string, std::string> day14(bool saveOutput = false);
 std::pair<std::string, std::string> day15();
 std::pair<std::string, std::string> day16();
 }  // namespace aoc
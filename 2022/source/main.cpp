@@ -27,7 +27,7 @@ int main(const int argc, const char* argv[]) {
             bblp::aoc::day11,
             bblp::aoc::day12,
             []() { return bblp::aoc::day13(true); },
-            bblp::aoc::day14,
+            []() { return bblp::aoc::day14(false); },
             bblp::aoc::day15,
             bblp::aoc::day16};
         bblp::aoc::Application app{argc, argv, days};
@@ -1,11 +1,28 @@
 #include <gtest/gtest.h>
 
+#include "bblp/aoc/scoped_puzzle_input.hpp"
 #include "days/days.hpp"
 
 namespace bblp::aoc::test {
 TEST(Day16, test) {
     const auto result = day16();
     EXPECT_EQ("1559", result.first);
-    EXPECT_EQ("", result.second);
+}
+
+TEST(Day16, example) {
+    const ScopedPuzzleInput input{"day16",
+                                  "Valve AA has flow rate=0; tunnels lead to valves DD, II, BB\n"
+                                  "Valve BB has flow rate=13; tunnels lead to valves CC, AA\n"
+                                  "Valve CC has flow rate=2; tunnels lead to valves DD, BB\n"
+                                  "Valve DD has flow rate=20; tunnels lead to valves CC, AA, EE\n"
+                                  "Valve EE has flow rate=3; tunnels lead to valves FF, DD\n"
+                                  "Valve FF has flow rate=0; tunnels lead to valves EE, GG\n"
+                                  "Valve GG has flow rate=0; tunnels lead to valves FF, HH\n"
+                                  "Valve HH has flow rate=22; tunnel leads to valve GG\n"
+                                  "Valve II has flow rate=0; tunnels lead to valves AA, JJ\n"
+                                  "Valve JJ has flow rate=21; tunnel leads to valve II\n"};
+    const auto result = day16();
+    EXPECT_EQ("1651", result.first);
+    EXPECT_EQ("1707", result.second);
 }
 };  // namespace bblp::aoc::test
@@ -3,9 +3,11 @@
 #include "bblp/aoc/file_utils.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstdlib>
 #include <numeric>
-#include <regex>
+#include <string_view>
 #include <vector>
 
 namespace bblp::aoc {
@@ -21,34 +23,103 @@ auto parse(const std::filesystem::path& filePath) {
     return input;
 }
 
-int toNumber(const std::string& val) {
-    if (val.length() == 1) {
-        return std::stoi(val);
+constexpr std::array<std::string_view, 9U> DIGIT_WORDS{"one", "two",   "three", "four", "five",
+                                                      "six", "seven", "eight", "nine"};
+
+// Trie over the spelled-out digits, built at compile time. Each word is inserted either as is or reversed, so the
+// same structure serves the forward scan for the first digit and the backward scan for the last one.
+struct DigitTrie {
+    static constexpr std::size_t MAX_NODES = 64U;
+    static constexpr std::size_t ALPHABET_SIZE = 26U;
+    static constexpr uint8_t NO_NODE = 0U;
+
+    struct Node {
+        std::array<uint8_t, ALPHABET_SIZE> next{};
+        int8_t value{-1};
+    };
+
+    std::array<Node, MAX_NODES> nodes{};
+    std::size_t size{1U};
+};
+
+constexpr DigitTrie buildDigitTrie(const bool reversed) {
+    DigitTrie trie;
+    for (std::size_t digit = 0U; digit < DIGIT_WORDS.size(); ++digit) {
+        const auto word = DIGIT_WORDS[digit];
+        std::size_t node = 0U;
+        for (std::size_t i = 0U; i < word.size(); ++i) {
+            const auto c = reversed ? word[word.size() - 1U - i] : word[i];
+            auto& next = trie.nodes[node].next[static_cast<std::size_t>(c - 'a')];
+            if (next == DigitTrie::NO_NODE) {
+                next = static_cast<uint8_t>(trie.size++);
+            }
+            node = next;
+        }
+        trie.nodes[node].value = static_cast<int8_t>(digit + 1U);
     }
+    return trie;
+}
+
+constexpr DigitTrie FORWARD_TRIE = buildDigitTrie(false);
+constexpr DigitTrie BACKWARD_TRIE = buildDigitTrie(true);
 
-    if (val == "zero") {
-        return 0;
-    } else if (val == "one") {
-        return 1;
-    } else if (val == "two") {
-        return 2;
-    } else if (val == "three") {
-        return 3;
-    } else if (val == "four") {
-        return 4;
-    } else if (val == "five") {
-        return 5;
-    } else if (val == "six") {
-        return 6;
-    } else if (val == "seven") {
-        return 7;
-    } else if (val == "eight") {
-        return 8;
-    } else if (val == "nine") {
-        return 9;
-    } else {
-        throw std::logic_error("Invalid toNumber() parameter: " + val);
+bool isDigit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isLowercaseLetter(const char c) {
+    return c >= 'a' && c <= 'z';
+}
+
+// Returns the digit (written or spelled out) starting at pos when walking in the given direction, or -1 if none.
+template <bool Forward>
+int matchDigitAt(const DigitTrie& trie, const std::string_view line, std::size_t pos) {
+    if (isDigit(line[pos])) {
+        return line[pos] - '0';
     }
+
+    std::size_t node = 0U;
+    while (true) {
+        const auto c = line[pos];
+        if (!isLowercaseLetter(c)) {
+            return -1;
+        }
+        node = trie.nodes[node].next[static_cast<std::size_t>(c - 'a')];
+        if (node == DigitTrie::NO_NODE) {
+            return -1;
+        }
+        if (trie.nodes[node].value >= 0) {
+            return trie.nodes[node].value;
+        }
+        if constexpr (Forward) {
+            if (++pos == line.size()) {
+                return -1;
+            }
+        } else {
+            if (pos-- == 0U) {
+                return -1;
+            }
+        }
+    }
+}
+
+std::pair<int, int> findFirstAndLastDigit(const std::string_view line) {
+    int first{0};
+    for (std::size_t pos = 0U; pos < line.size(); ++pos) {
+        if (const auto digit = matchDigitAt<true>(FORWARD_TRIE, line, pos); digit >= 0) {
+            first = digit;
+            break;
+        }
+    }
+
+    int last{0};
+    for (std::size_t pos = line.size(); pos > 0U; --pos) {
+        if (const auto digit = matchDigitAt<false>(BACKWARD_TRIE, line, pos - 1U); digit >= 0) {
+            last = digit;
+            break;
+        }
+    }
+    return {first, last};
 }
 
 int calculateCalibration(const std::vector<std::pair<int, int>> values) {
@@ -71,33 +142,9 @@ int calculatePartOne(const std::vector<std::string>& input) {
 }
 
 int calculatePartTwo(const std::vector<std::string>& input) {
-    const std::string pattern{"1|2|3|4|5|6|7|8|9|one|two|three|four|five|six|seven|eight|nine"};
-    std::regex regex{pattern};
-    std::smatch match;
-
     std::vector<std::pair<int, int>> partTwo(input.size());
     std::transform(input.cbegin(), input.cend(), partTwo.begin(),
-                   [&match, &regex](const auto& line) -> std::pair<int, int> {
-                       static constexpr size_t LINE_BUFFER_SIZE = 100U;
-
-                       std::vector<std::string> results;
-                       results.reserve(LINE_BUFFER_SIZE);
-
-                       std::string search = line;
-                       while (std::regex_search(search, match, regex)) {
-                           const auto str = match[0].str();
-                           results.push_back(str);
-                           if (str.length() > 1) {
-                               // case for sevenine etc.
-                               search = match[0].str().back();
-                               search += match.suffix();
-                           } else {
-                               search = match.suffix();
-                           }
-                       }
-
-                       return {toNumber(results.front()), toNumber(results.back())};
-                   });
+                   [](const auto& line) { return findFirstAndLastDigit(line); });
     return calculateCalibration(partTwo);
 }
 }  // namespace
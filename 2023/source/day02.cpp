@@ -1,59 +1,77 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
 #include <cstdlib>
 #include <numeric>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
 
-struct Record {
-    uint32_t red;
-    uint32_t green;
-    uint32_t blue;
-};
-
 struct Game {
     uint32_t id;
-    std::vector<Record> records;
+    uint32_t maxRed;
+    uint32_t maxGreen;
+    uint32_t maxBlue;
 };
 
-int parseGameId(const std::string& input) {
-    const auto parts = split(input, " ");
-    if (parts.size() != 2) {
+bool isDigit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+uint32_t parseNumber(const std::string_view line, std::size_t& pos) {
+    uint32_t number{0U};
+    while (pos < line.size() && isDigit(line[pos])) {
+        number = number * 10U + static_cast<uint32_t>(line[pos] - '0');
+        ++pos;
+    }
+    return number;
+}
+
+// Parses "Game <id>: <n> <colour>, ...; ..." in a single left-to-right scan, keeping only the per-colour maximum
+// since record boundaries do not matter for either part.
+Game parseGame(const std::string_view line) {
+    std::size_t pos = line.find_first_of("0123456789");
+    if (pos == std::string_view::npos) {
         throw std::logic_error("Invalid line format");
     }
 
-    return std::stoul(parts.back());
-}
+    Game game{parseNumber(line, pos), 0U, 0U, 0U};
+    if (pos >= line.size() || line[pos] != ':') {
+        throw std::logic_error("Invalid line format");
+    }
+
+    while (pos < line.size()) {
+        if (!isDigit(line[pos])) {
+            ++pos;
+            continue;
+        }
 
-std::vector<Record> parseGameRecords(const std::string& input) {
-    const auto recordStrings = split(input, ";");
-    std::vector<Record> records(recordStrings.size());
-    std::transform(recordStrings.cbegin(), recordStrings.cend(), records.begin(), [](const std::string& recordString) {
-        Record record{0U, 0U, 0U};
-        const auto revealStrings = split(recordString, ",");
-        for (auto iter = revealStrings.cbegin(); iter != revealStrings.cend(); ++iter) {
-            const auto str = trim(*iter);
-            if (str.find("red") != std::string::npos) {
-                record.red = std::stoul(split(str, " ").front());
-            }
-            if (str.find("green") != std::string::npos) {
-                record.green = std::stoul(split(str, " ").front());
-            }
-            if (str.find("blue") != std::string::npos) {
-                record.blue = std::stoul(split(str, " ").front());
-            }
+        const auto count = parseNumber(line, pos);
+        if (pos + 1U >= line.size()) {
+            throw std::logic_error("Invalid line format");
         }
-        return record;
-    });
 
-    return records;
+        switch (line[pos + 1U]) {
+            case 'r':
+                game.maxRed = std::max(game.maxRed, count);
+                break;
+            case 'g':
+                game.maxGreen = std::max(game.maxGreen, count);
+                break;
+            case 'b':
+                game.maxBlue = std::max(game.maxBlue, count);
+                break;
+            default:
+                throw std::logic_error("Invalid colour");
+        }
+        pos = line.find_first_of(",;", pos);
+    }
+    return game;
 }
 
 auto parse(const std::filesystem::path& filePath) {
@@ -61,43 +79,17 @@ auto parse(const std::filesystem::path& filePath) {
 
     std::vector<Game> input;
     input.reserve(BUFFER_SIZE);
-    const auto lineCallback = [&input](const std::string& line) {
-        const auto parts = split(line, ":");
-        if (parts.size() != 2) {
-            throw std::logic_error("Invalid line format");
-        }
-        input.emplace_back(parseGameId(parts.front()), parseGameRecords(parts.back()));
-    };
+    const auto lineCallback = [&input](const std::string& line) { input.push_back(parseGame(line)); };
     parseInput(filePath, lineCallback);
     return input;
 }
 
 bool isGamePossible(const Game& game) {
-    for (auto iter = game.records.cbegin(); iter != game.records.cend(); ++iter) {
-        if (iter->red > 12 || iter->green > 13 || iter->blue > 14) {
-            return false;
-        }
-    }
-    return true;
+    return game.maxRed <= 12 && game.maxGreen <= 13 && game.maxBlue <= 14;
 }
 
 uint32_t findMinimalPossiblePower(const Game& game) {
-    uint32_t minRed{0U};
-    uint32_t minGreen{0U};
-    uint32_t minBlue{0U};
-
-    for (auto iter = game.records.cbegin(); iter != game.records.cend(); ++iter) {
-        if (iter->red > minRed) {
-            minRed = iter->red;
-        }
-        if (iter->green > minGreen) {
-            minGreen = iter->green;
-        }
-        if (iter->blue > minBlue) {
-            minBlue = iter->blue;
-        }
-    }
-    return minRed * minGreen * minBlue;
+    return game.maxRed * game.maxGreen * game.maxBlue;
 }
 
 uint32_t calculatePartOne(const std::vector<Game>& input) {
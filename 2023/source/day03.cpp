@@ -1,36 +1,27 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/point.hpp"
-#include "bblp/aoc/string_utils.hpp"
+#include "bblp/aoc/grid.hpp"
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <cstdlib>
-#include <iostream>
-#include <numeric>
-#include <stdexcept>
-#include <string_view>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
 
-struct Number {
-    Point position;
-    std::string value;
-};
+constexpr int32_t NO_NUMBER = -1;
+constexpr std::size_t MAX_ADJACENT_NUMBERS = 8U;
 
-struct Symbol {
-    Point position;
-    std::string value;
+// Every cell covered by a number holds that number's index in `values`, all other cells hold NO_NUMBER.
+struct Schematic {
+    std::vector<uint32_t> values;
+    Grid<int32_t> labels;
 };
 
-
-struct GearPart {
-    Point position;
-    std::vector<Number> parts;
-};
+using AdjacentNumbers = std::array<int32_t, MAX_ADJACENT_NUMBERS>;
 
 auto parse(const std::filesystem::path& filePath) {
     static constexpr std::size_t BUFFER_SIZE = 10000;
@@ -50,153 +41,91 @@ bool isSymbol(const char c) {
     return !isNumber(c) && c != '.';
 }
 
-std::vector<Number> findAllNumbers(const std::vector<std::string>& input) {
-    std::vector<Number> numbers;
-    for (std::size_t y = 0U; y < input.size(); ++y) {
-        const auto& row = input.at(y);
-
-        for (std::size_t x = 0U; x < row.size(); ++x) {
-            if (isNumber(row.at(x))) {
-                const auto numberStart = x;
-                std::string number{""};
-                while (x < row.size() && isNumber(row.at(x))) {
-                    number += row.at(x);
-                    ++x;
-                }
-                numbers.emplace_back(Point{numberStart, y}, number);
-            }
-        }
-    }
-    return numbers;
-}
-
-bool isAdjacentToSymbol(const std::vector<std::string>& input, const Number& number) {
-    const auto& start = number.position;
-    const auto length = number.value.length();
+Schematic labelNumbers(const std::vector<std::string>& input) {
+    const auto height = static_cast<int64_t>(input.size());
+    const auto width = static_cast<int64_t>(input.empty() ? 0U : input.front().size());
 
-    if (start.y > 0) {
-        const auto& row = input.at(start.y - 1);
-        for (int64_t x = start.x - 1; x <= start.x + length; ++x) {
-            if (x < 0 || x >= row.size()) {
+    Schematic schematic{{}, Grid<int32_t>{width, height, NO_NUMBER}};
+    for (int64_t y = 0; y < height; ++y) {
+        const auto& row = input[y];
+        for (int64_t x = 0; x < width; ++x) {
+            if (!isNumber(row[x])) {
                 continue;
             }
 
-            if (isSymbol(row.at(x))) {
-                return true;
+            const auto id = static_cast<int32_t>(schematic.values.size());
+            uint32_t value{0U};
+            for (; x < width && isNumber(row[x]); ++x) {
+                value = value * 10U + static_cast<uint32_t>(row[x] - '0');
+                schematic.labels.set(x, y, id);
             }
+            schematic.values.push_back(value);
         }
     }
-    if (start.y < static_cast<int64_t>(input.size()) - 1) {
-        const auto& row = input.at(start.y + 1);
-        for (int64_t x = start.x - 1; x <= start.x + length; ++x) {
-            if (x < 0 || x >= row.size()) {
-                continue;
-            }
+    return schematic;
+}
 
-            if (isSymbol(row.at(x))) {
-                return true;
+std::size_t findAdjacentNumbers(const Schematic& schematic, const int64_t x, const int64_t y, AdjacentNumbers& ids) {
+    const auto& labels = schematic.labels;
+    std::size_t count{0U};
+    for (auto ny = std::max<int64_t>(y - 1, 0); ny <= std::min(y + 1, labels.height() - 1); ++ny) {
+        for (auto nx = std::max<int64_t>(x - 1, 0); nx <= std::min(x + 1, labels.width() - 1); ++nx) {
+            const auto id = labels.at(nx, ny);
+            if (id != NO_NUMBER && std::find(ids.cbegin(), ids.cbegin() + count, id) == ids.cbegin() + count) {
+                ids[count++] = id;
             }
         }
     }
-
-    const auto& row = input.at(start.y);
-    if (start.x > 0 && isSymbol(row.at(start.x - 1))) {
-        return true;
-    }
-    if (start.x < row.size() - static_cast<int64_t>(length) - 1 && isSymbol(row.at(start.x + length))) {
-        return true;
-    }
-    return false;
+    return count;
 }
 
-std::vector<Symbol> findAdjacentSymbols(const std::vector<std::string>& input, const Number& number) {
-    std::vector<Symbol> adjacentSymbols;
-
-    const auto& start = number.position;
-    const auto length = number.value.length();
-
-    if (start.y > 0) {
-        const auto& row = input.at(start.y - 1);
-        for (int64_t x = start.x - 1; x <= start.x + length; ++x) {
-            if (x < 0 || x >= row.size()) {
+uint32_t calculatePartOne(const std::vector<std::string>& input, const Schematic& schematic) {
+    std::vector<bool> isPartNumber(schematic.values.size(), false);
+    AdjacentNumbers ids{};
+    for (int64_t y = 0; y < schematic.labels.height(); ++y) {
+        for (int64_t x = 0; x < schematic.labels.width(); ++x) {
+            if (!isSymbol(input[y][x])) {
                 continue;
             }
 
-            if (isSymbol(row.at(x))) {
-                adjacentSymbols.emplace_back(Point{x, start.y - 1}, std::string{row.at(x)});
-            }
-        }
-    }
-    if (start.y < static_cast<int64_t>(input.size()) - 1) {
-        const auto& row = input.at(start.y + 1);
-        for (int64_t x = start.x - 1; x <= start.x + length; ++x) {
-            if (x < 0 || x >= row.size()) {
-                continue;
-            }
-
-            if (isSymbol(row.at(x))) {
-                adjacentSymbols.emplace_back(Point{x, start.y + 1}, std::string{row.at(x)});
+            const auto count = findAdjacentNumbers(schematic, x, y, ids);
+            for (std::size_t i = 0U; i < count; ++i) {
+                isPartNumber[ids[i]] = true;
             }
         }
     }
 
-    const auto& row = input.at(start.y);
-    if (start.x > 0 && isSymbol(row.at(start.x - 1))) {
-        adjacentSymbols.emplace_back(Point{start.x - 1, start.y}, std::string{row.at(start.x - 1)});
-    }
-    if (start.x < row.size() - static_cast<int64_t>(length) - 1 && isSymbol(row.at(start.x + length))) {
-        adjacentSymbols.emplace_back(Point{start.x + length, start.y}, std::string{row.at(start.x + length)});
-    }
-    return adjacentSymbols;
-}
-
-uint32_t calculatePartOne(const std::vector<std::string>& input) {
     uint32_t result{0U};
-    const auto numbers = findAllNumbers(input);
-    for (const auto& number : numbers) {
-        if (isAdjacentToSymbol(input, number)) {
-            result += std::stoul(number.value);
+    for (std::size_t id = 0U; id < schematic.values.size(); ++id) {
+        if (isPartNumber[id]) {
+            result += schematic.values[id];
         }
     }
     return result;
 }
 
-uint64_t calculatePartTwo(const std::vector<std::string>& input) {
+uint64_t calculatePartTwo(const std::vector<std::string>& input, const Schematic& schematic) {
     uint64_t result{0U};
-    const auto numbers = findAllNumbers(input);
-    std::vector<GearPart> allGears;
-    for (const auto& number : numbers) {
-        const auto adjacentSymbols = findAdjacentSymbols(input, number);
-        for (const auto& symbol : adjacentSymbols) {
-            if (symbol.value != "*") {
+    AdjacentNumbers ids{};
+    for (int64_t y = 0; y < schematic.labels.height(); ++y) {
+        for (int64_t x = 0; x < schematic.labels.width(); ++x) {
+            if (input[y][x] != '*') {
                 continue;
             }
 
-            auto iter = std::find_if(allGears.begin(), allGears.end(), [&symbol](const GearPart& gear) {
-                return symbol.position == gear.position;
-            });
-
-            if (iter == allGears.end()) {
-                allGears.push_back(GearPart{symbol.position, {number}});
-            } else {
-                iter->parts.push_back(number);
+            if (findAdjacentNumbers(schematic, x, y, ids) == 2U) {
+                result += static_cast<uint64_t>(schematic.values[ids[0]]) * schematic.values[ids[1]];
             }
         }
     }
-
-    for (const auto& gear : allGears) {
-        if (gear.parts.size() == 2U) {
-            result += (static_cast<uint64_t>(std::stoi(gear.parts.at(0).value)) * std::stoi(gear.parts.at(1).value));
-        }
-    }
-
     return result;
 }
 }  // namespace
 
 std::pair<std::string, std::string> day03() {
     const auto input = parse("resources/day03.txt");
+    const auto schematic = labelNumbers(input);
 
-    return {std::to_string(calculatePartOne(input)), std::to_string(calculatePartTwo(input))};
+    return {std::to_string(calculatePartOne(input, schematic)), std::to_string(calculatePartTwo(input, schematic))};
 }
 }  // namespace bblp::aoc
@@ -1,35 +1,39 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/point.hpp"
 #include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
-#include <array>
+#include <bitset>
+#include <cstdint>
 #include <cstdlib>
-#include <iostream>
-#include <numeric>
 #include <stdexcept>
-#include <string_view>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
+// All card numbers are below 100, so a set of them fits in a 128-bit mask.
+static constexpr std::size_t MAX_CARD_NUMBER = 128U;
+using NumberSet = std::bitset<MAX_CARD_NUMBER>;
+
 struct Scratchcard {
     uint32_t id;
-    uint32_t instances;
-    std::vector<uint32_t> winningNumbers;
-    std::vector<uint32_t> scratchedNumbers;
+    NumberSet winningNumbers;
+    NumberSet scratchedNumbers;
 };
 
-std::vector<uint32_t> parseNumbers(const std::string& str) {
+NumberSet parseNumbers(const std::string& str) {
     const auto parts = split(trim(str), " ");
-    std::vector<uint32_t> numbers;
+    NumberSet numbers;
     for (auto iter = parts.cbegin(); iter != parts.cend(); ++iter) {
         if (iter->empty()) {
             continue;
         }
-        numbers.emplace_back(std::stoul(*iter));
+        const auto number = std::stoul(*iter);
+        if (number >= MAX_CARD_NUMBER) {
+            throw std::out_of_range("Card number too large: " + *iter);
+        }
+        numbers.set(number);
     }
     return numbers;
 }
@@ -39,7 +43,7 @@ Scratchcard parseScratchcard(const std::string& line) {
     const auto id = std::stoul(split(parts.at(0), " ").back());
     const auto numberParts = split(parts.at(1), "|");
 
-    return Scratchcard{id, 1U, parseNumbers(numberParts.at(0)), parseNumbers(numberParts.at(1))};
+    return Scratchcard{id, parseNumbers(numberParts.at(0)), parseNumbers(numberParts.at(1))};
 }
 
 auto parse(const std::filesystem::path& filePath) {
@@ -52,49 +56,40 @@ auto parse(const std::filesystem::path& filePath) {
     return input;
 }
 
+std::size_t countMatches(const Scratchcard& card) {
+    return (card.winningNumbers & card.scratchedNumbers).count();
+}
+
 uint32_t calculatePartOne(const std::vector<Scratchcard>& input) {
     uint32_t result{0U};
     for (const auto& card : input) {
-        uint32_t cardScore{0U};
-        for (const auto number : card.scratchedNumbers) {
-            if (std::find(card.winningNumbers.cbegin(), card.winningNumbers.cend(), number) !=
-                card.winningNumbers.cend()) {
-                if (cardScore == 0U) {
-                    cardScore = 1U;
-                } else {
-                    cardScore *= 2;
-                }
-            }
+        const auto matches = countMatches(card);
+        if (matches > 0U) {
+            result += 1U << (matches - 1U);
         }
-        result += cardScore;
     }
     return result;
 }
 
 uint64_t calculatePartTwo(const std::vector<Scratchcard>& input) {
-    std::vector<Scratchcard> copy{input.cbegin(), input.cend()};
-
-    for (const auto& card : copy) {
-        uint32_t cardScore{0U};
-        for (const auto number : card.scratchedNumbers) {
-            if (std::find(card.winningNumbers.cbegin(), card.winningNumbers.cend(), number) !=
-                card.winningNumbers.cend()) {
-                ++cardScore;
-            }
-        }
+    // copiesDelta[i] holds the change in won copies between card i - 1 and card i, so a card winning copies of a
+    // whole range of following cards costs two updates instead of one per card.
+    std::vector<int64_t> copiesDelta(input.size() + 1U, 0);
+    int64_t wonCopies{0};
+    uint64_t result{0U};
+
+    for (std::size_t i = 0U; i < input.size(); ++i) {
+        wonCopies += copiesDelta[i];
+        const auto instances = 1 + wonCopies;
+        result += static_cast<uint64_t>(instances);
 
-        for (auto i = 0U; i < cardScore; ++i) {
-            const auto winningIndex = card.id + i;
-            if (winningIndex < copy.size()) {
-                copy.at(winningIndex).instances += card.instances;
-            } else {
-                std::cout << "sadge" << '\n';
-            }
+        const auto lastWonIndex = std::min(i + countMatches(input[i]), input.size() - 1U);
+        if (lastWonIndex > i) {
+            copiesDelta[i + 1U] += instances;
+            copiesDelta[lastWonIndex + 1U] -= instances;
         }
     }
-
-    return std::accumulate(copy.cbegin(), copy.cend(), 0U,
-                           [](uint32_t sum, const Scratchcard& card) { return sum + card.instances; });
+    return result;
 }
 }  // namespace
 
@@ -1,385 +1,131 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/point.hpp"
+#include "bblp/aoc/solution.hpp"
 #include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <cstdlib>
-#include <iostream>
-#include <numeric>
-#include <optional>
+#include <functional>
 #include <stdexcept>
 #include <string_view>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
 enum class Type { HIGH_CARD, ONE_PAIR, TWO_PAIR, THREE_OF_A_KIND, FULL_HOUSE, FOUR_OF_A_KIND, FIVE_OF_A_KIND };
-enum class Card {
-    CARD_2,
-    CARD_3,
-    CARD_4,
-    CARD_5,
-    CARD_6,
-    CARD_7,
-    CARD_8,
-    CARD_9,
-    CARD_T,
-    CARD_J,
-    CARD_Q,
-    CARD_K,
-    CARD_A
-};
 
-enum class CardWithJoker {
-    CARD_J,
-    CARD_2,
-    CARD_3,
-    CARD_4,
-    CARD_5,
-    CARD_6,
-    CARD_7,
-    CARD_8,
-    CARD_9,
-    CARD_T,
-    CARD_Q,
-    CARD_K,
-    CARD_A
-};
+using Rank = uint8_t;
 
-Type calculateType(const std::vector<Card>& hand) {
-    std::unordered_map<Card, uint32_t> cardsCount;
-    for (const auto card : hand) {
-        if (cardsCount.contains(card)) {
-            cardsCount.at(card) += 1U;
-        } else {
-            cardsCount.insert({card, 1U});
-        }
-    }
+constexpr std::size_t HAND_SIZE = 5U;
+constexpr std::size_t RANK_COUNT = 13U;
+constexpr std::string_view CARD_ORDER = "23456789TJQKA";
+constexpr Rank RANK_JOKER = 9U;
+constexpr uint32_t RANK_BITS = 4U;
 
-    if (std::find_if(cardsCount.cbegin(), cardsCount.cend(), [](const auto& pair) { return pair.second == 5U; }) !=
-        cardsCount.cend()) {
-        return Type::FIVE_OF_A_KIND;
-    } else if (std::find_if(cardsCount.cbegin(), cardsCount.cend(),
-                            [](const auto& pair) { return pair.second == 4U; }) != cardsCount.cend()) {
-        return Type::FOUR_OF_A_KIND;
-    } else if (std::find_if(cardsCount.cbegin(), cardsCount.cend(),
-                            [](const auto& pair) { return pair.second == 3U; }) != cardsCount.cend()) {
-        if (std::find_if(cardsCount.cbegin(), cardsCount.cend(), [](const auto& pair) { return pair.second == 2U; }) !=
-            cardsCount.cend()) {
-            return Type::FULL_HOUSE;
-        } else {
-            return Type::THREE_OF_A_KIND;
-        }
-    } else if (auto iter = std::find_if(cardsCount.cbegin(), cardsCount.cend(),
-                                        [](const auto& pair) { return pair.second == 2U; }) != cardsCount.cend()) {
-        const auto num =
-            std::accumulate(cardsCount.cbegin(), cardsCount.cend(), 0U, [](uint32_t sum, const auto& pair) {
-                if (pair.second == 2U) {
-                    return sum + 1U;
-                } else {
-                    return sum;
-                }
-            });
-        if (num == 2U) {
-            return Type::TWO_PAIR;
-        } else {
-            return Type::ONE_PAIR;
-        }
-    } else {
-        return Type::HIGH_CARD;
-    }
-}
+using Ranks = std::array<Rank, HAND_SIZE>;
 
-Type calculateTypeWithJoker(const std::vector<CardWithJoker>& hand) {
-    std::unordered_map<CardWithJoker, uint32_t> cardsCount;
-    for (const auto card : hand) {
-        if (cardsCount.contains(card)) {
-            cardsCount.at(card) += 1U;
-        } else {
-            cardsCount.insert({card, 1U});
-        }
+Rank convertToRank(const char card) {
+    const auto pos = CARD_ORDER.find(card);
+    if (pos == std::string_view::npos) {
+        throw std::logic_error("Invalid card");
     }
+    return static_cast<Rank>(pos);
+}
 
-    auto jokerIter = cardsCount.find(CardWithJoker::CARD_J);
-    const auto jokerCount = jokerIter != cardsCount.cend() ? jokerIter->second : 0U;
-
-    if (jokerCount == 5U || std::find_if(cardsCount.cbegin(), cardsCount.cend(),
-                     [&jokerCount](const auto& pair) { return pair.second + jokerCount == 5U; }) !=
-        cardsCount.cend()) {
+Type classifyCounts(std::array<uint8_t, RANK_COUNT> counts, const uint8_t jokers) {
+    std::sort(counts.begin(), counts.end(), std::greater<>());
+    counts[0] = static_cast<uint8_t>(counts[0] + jokers);
+    if (counts[0] == 5U) {
         return Type::FIVE_OF_A_KIND;
-    } else if (std::find_if(cardsCount.cbegin(), cardsCount.cend(),
-                            [&jokerCount](const auto& pair) { return pair.first != CardWithJoker::CARD_J && pair.second + jokerCount == 4U; }) != cardsCount.cend()) {
+    }
+    if (counts[0] == 4U) {
         return Type::FOUR_OF_A_KIND;
-    } else if (std::find_if(cardsCount.cbegin(), cardsCount.cend(), [&jokerCount](const auto& pair) {
-                   return pair.second + jokerCount == 3U;
-               }) != cardsCount.cend()) {
-        auto iter = std::find_if(cardsCount.cbegin(), cardsCount.cend(),
-                                 [&jokerCount](const auto& pair) { return pair.second + jokerCount == 3U; });
-
-        if (std::find_if(cardsCount.cbegin(), cardsCount.cend(), [&iter](const auto& pair) {
-                return pair.first != CardWithJoker::CARD_J && iter->first != pair.first && pair.second == 2U;
-            }) !=
-            cardsCount.cend()) {
-            return Type::FULL_HOUSE;
-        } else {
-            return Type::THREE_OF_A_KIND;
-        }
-    } else if (auto iter = std::find_if(cardsCount.cbegin(), cardsCount.cend(), [&jokerCount](const auto& pair) {
-                               return pair.second + jokerCount == 2U;
-                           }) != cardsCount.cend()) {
-        if (jokerCount > 0U) {
-            return Type::ONE_PAIR;
-        }
-
-        const auto num =
-            std::accumulate(cardsCount.cbegin(), cardsCount.cend(), 0U, [](uint32_t sum, const auto& pair) {
-                if (pair.second == 2U) {
-                    return sum + 1U;
-                } else {
-                    return sum;
-                }
-            });
-        if (num == 2U) {
-            return Type::TWO_PAIR;
-        } else {
-            return Type::ONE_PAIR;
-        }
-    } else {
-        return Type::HIGH_CARD;
     }
+    if (counts[0] == 3U) {
+        return counts[1] == 2U ? Type::FULL_HOUSE : Type::THREE_OF_A_KIND;
+    }
+    if (counts[0] == 2U) {
+        return counts[1] == 2U ? Type::TWO_PAIR : Type::ONE_PAIR;
+    }
+    return Type::HIGH_CARD;
 }
 
-std::vector<Card> convertToCards(const std::string& str) {
-    std::vector<Card> cards(str.size());
-    std::transform(str.cbegin(), str.cend(), cards.begin(), [](const char c) -> Card {
-        switch (c) {
-            case '2':
-                return Card::CARD_2;
-            case '3':
-                return Card::CARD_3;
-            case '4':
-                return Card::CARD_4;
-            case '5':
-                return Card::CARD_5;
-            case '6':
-                return Card::CARD_6;
-            case '7':
-                return Card::CARD_7;
-            case '8':
-                return Card::CARD_8;
-            case '9':
-                return Card::CARD_9;
-            case 'T':
-                return Card::CARD_T;
-            case 'J':
-                return Card::CARD_J;
-            case 'Q':
-                return Card::CARD_Q;
-            case 'K':
-                return Card::CARD_K;
-            case 'A':
-                return Card::CARD_A;
-            default:
-                throw std::logic_error("Invalid card");
-        }
-    });
-    return cards;
-}
-
-std::vector<CardWithJoker> convertToCardsWithJoker(const std::string& str) {
-    std::vector<CardWithJoker> cards(str.size());
-    std::transform(str.cbegin(), str.cend(), cards.begin(), [](const char c) -> CardWithJoker {
-        switch (c) {
-            case '2':
-                return CardWithJoker::CARD_2;
-            case '3':
-                return CardWithJoker::CARD_3;
-            case '4':
-                return CardWithJoker::CARD_4;
-            case '5':
-                return CardWithJoker::CARD_5;
-            case '6':
-                return CardWithJoker::CARD_6;
-            case '7':
-                return CardWithJoker::CARD_7;
-            case '8':
-                return CardWithJoker::CARD_8;
-            case '9':
-                return CardWithJoker::CARD_9;
-            case 'T':
-                return CardWithJoker::CARD_T;
-            case 'J':
-                return CardWithJoker::CARD_J;
-            case 'Q':
-                return CardWithJoker::CARD_Q;
-            case 'K':
-                return CardWithJoker::CARD_K;
-            case 'A':
-                return CardWithJoker::CARD_A;
-            default:
-                throw std::logic_error("Invalid card");
-        }
-    });
-    return cards;
-}
-
-struct Hand {
-    Hand(const std::string& cards, uint64_t bid) : cards{convertToCards(cards)}, bid{bid}, type{calculateType(this->cards)} {}
-
-    std::vector<Card> cards;
-    uint64_t bid;
-    Type type;
-
-    std::weak_ordering operator<=>(const Hand& other) const;
+// Card ranks and both hand types (plain, and with jokers joining the largest group) are converted once; the parts
+// only differ in which type they pick and where the joker ranks.
+struct CamelCards {
+    std::vector<Ranks> ranks;
+    std::vector<Type> types;
+    std::vector<Type> typesWithJoker;
+    std::vector<uint64_t> bids;
 };
 
-struct HandWithJoker {
-    HandWithJoker(const std::string& cards, uint64_t bid)
-        : cards{convertToCardsWithJoker(cards)}, bid{bid}, type{calculateTypeWithJoker(this->cards)} {}
-
-    std::vector<CardWithJoker> cards;
-    uint64_t bid;
-    Type type;
-
-    std::weak_ordering operator<=>(const HandWithJoker& other) const;
-};
-
-std::weak_ordering Hand::operator<=>(const Hand& other) const {
-    if (type > other.type) {
-        return std::weak_ordering::greater;
-    } else if (type < other.type) {
-        return std::weak_ordering::less;
-    } else {
-        for (auto i = 0U; i < cards.size(); ++i) {
-            if (cards.at(i) < other.cards.at(i)) {
-                return std::weak_ordering::less;
-            } else if (cards.at(i) > other.cards.at(i)) {
-                return std::weak_ordering::greater;
-            }
+auto parse(const std::filesystem::path& filePath) {
+    CamelCards input;
+    const auto lineCallback = [&input](const std::string& line) {
+        const auto parts = split(line, " ");
+        if (parts.front().size() != HAND_SIZE) {
+            throw std::logic_error("Invalid hand: " + line);
         }
-        return std::weak_ordering::equivalent;
-    }
-}
 
-std::weak_ordering HandWithJoker::operator<=>(const HandWithJoker& other) const {
-    if (type > other.type) {
-        return std::weak_ordering::greater;
-    } else if (type < other.type) {
-        return std::weak_ordering::less;
-    } else {
-        for (auto i = 0U; i < cards.size(); ++i) {
-            if (cards.at(i) < other.cards.at(i)) {
-                return std::weak_ordering::less;
-            } else if (cards.at(i) > other.cards.at(i)) {
-                return std::weak_ordering::greater;
-            }
+        Ranks ranks{};
+        std::array<uint8_t, RANK_COUNT> counts{};
+        for (std::size_t i = 0U; i < HAND_SIZE; ++i) {
+            ranks[i] = convertToRank(parts.front()[i]);
+            ++counts[ranks[i]];
         }
-        return std::weak_ordering::equivalent;
-    }
-}
-
-auto parse(const std::filesystem::path& filePath) {
-    static constexpr std::size_t BUFFER_SIZE = 10000;
 
-    std::vector<std::pair<std::string, uint64_t>> input;
-    const auto lineCallback = [&input](const std::string& line) {
-        const auto parts = split(line, " ");
-        input.emplace_back(parts.front(), std::stoul(parts.back()));
+        input.ranks.push_back(ranks);
+        input.types.push_back(classifyCounts(counts, 0U));
+        const auto jokers = std::exchange(counts[RANK_JOKER], uint8_t{0U});
+        input.typesWithJoker.push_back(classifyCounts(counts, jokers));
+        input.bids.push_back(std::stoul(parts.back()));
     };
     parseInput(filePath, lineCallback);
     return input;
 }
 
-std::ostream& operator<<(std::ostream& stream, CardWithJoker card) {
-    switch (card) {
-        case CardWithJoker::CARD_J:
-            stream << "J";
-            break;
-        case CardWithJoker::CARD_2:
-            stream << "2";
-            break;
-        case CardWithJoker::CARD_3:
-            stream << "3";
-            break;
-        case CardWithJoker::CARD_4:
-            stream << "4";
-            break;
-        case CardWithJoker::CARD_5:
-            stream << "5";
-            break;
-        case CardWithJoker::CARD_6:
-            stream << "6";
-            break;
-        case CardWithJoker::CARD_7:
-            stream << "7";
-            break;
-        case CardWithJoker::CARD_8:
-            stream << "8";
-            break;
-        case CardWithJoker::CARD_9:
-            stream << "9";
-            break;
-        case CardWithJoker::CARD_T:
-            stream << "T";
-            break;
-        case CardWithJoker::CARD_Q:
-            stream << "Q";
-            break;
-        case CardWithJoker::CARD_K:
-            stream << "K";
-            break;
-        case CardWithJoker::CARD_A:
-            stream << "A";
-            break;
+// Jokers rank below every other card; the cards that ranked below the jack move up by one.
+Rank rankWithJoker(const Rank rank) {
+    if (rank == RANK_JOKER) {
+        return 0U;
     }
-
-    return stream;
+    return rank < RANK_JOKER ? static_cast<Rank>(rank + 1U) : rank;
 }
 
-std::ostream& operator<<(std::ostream& stream, const std::vector<CardWithJoker>& cards) {
-    for (auto card : cards) {
-        stream << card;
+// Orders the hands by one packed key per hand (type first, then the card ranks in order) and sums bid times rank.
+uint64_t calculateTotalWinnings(const CamelCards& input, const bool withJoker) {
+    std::vector<std::pair<uint32_t, uint64_t>> keyedBids;
+    keyedBids.reserve(input.bids.size());
+    for (std::size_t i = 0U; i < input.bids.size(); ++i) {
+        auto key = static_cast<uint32_t>(withJoker ? input.typesWithJoker[i] : input.types[i]);
+        for (const auto rank : input.ranks[i]) {
+            key = (key << RANK_BITS) | (withJoker ? rankWithJoker(rank) : rank);
+        }
+        keyedBids.emplace_back(key, input.bids[i]);
     }
+    std::sort(keyedBids.begin(), keyedBids.end());
 
-    return stream;
-}
-
-uint64_t calculatePartOne(const std::vector<std::pair<std::string, uint64_t>>& input) {
     uint64_t result{0U};
-    std::vector<Hand> hands;
-    hands.reserve(input.size());
-    for (const auto& pair : input) {
-        hands.emplace_back(pair.first, pair.second);
-    }
-    std::sort(hands.begin(), hands.end(), std::less<Hand>());
-    for (auto i = 0U; i < hands.size(); ++i) {
-        result += hands.at(i).bid * static_cast<uint64_t>(i + 1U);
+    for (std::size_t i = 0U; i < keyedBids.size(); ++i) {
+        result += keyedBids[i].second * static_cast<uint64_t>(i + 1U);
     }
     return result;
 }
 
-uint64_t calculatePartTwo(const std::vector<std::pair<std::string, uint64_t>>& input) {
-    uint64_t result{0U};
-    std::vector<HandWithJoker> hands;
-    hands.reserve(input.size());
-    for (const auto& pair : input) {
-        hands.emplace_back(pair.first, pair.second);
-    }
-    std::sort(hands.begin(), hands.end(), std::less<HandWithJoker>());
-    for (auto i = 0U; i < hands.size(); ++i) {
-        result += hands.at(i).bid * static_cast<uint64_t>(i + 1U);
-    }
-    return result;
+uint64_t calculatePartOne(const CamelCards& input) {
+    return calculateTotalWinnings(input, false);
+}
+
+uint64_t calculatePartTwo(const CamelCards& input) {
+    return calculateTotalWinnings(input, true);
 }
 }  // namespace
 
 std::pair<std::string, std::string> day07() {
-    const auto input = parse("resources/day07.txt");
-
-    return {std::to_string(calculatePartOne(input)), std::to_string(calculatePartTwo(input))};
+    return solve([]() { return parse("resources/day07.txt"); }, calculatePartOne, calculatePartTwo);
 }
 }  // namespace bblp::aoc
@@ -1,128 +1,379 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/point.hpp"
-#include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <cstdlib>
-#include <iostream>
+#include <future>
+#include <limits>
 #include <numeric>
 #include <optional>
 #include <stdexcept>
 #include <string_view>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
 
-struct Module {
-    std::string left;
-    std::string right;
-};
+static constexpr std::size_t NAME_LENGTH = 3U;
+static constexpr uint32_t NAME_RADIX = 36U;
+static constexpr uint32_t NAME_KEY_COUNT = NAME_RADIX * NAME_RADIX * NAME_RADIX;
+static constexpr uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
 
-struct Network {
-    std::string instructions;
+enum Direction : uint8_t { LEFT = 0U, RIGHT = 1U };
 
-    std::unordered_map<std::string, Module> nodes;
+// Nodes are interned into dense ids in order of first appearance; `keys` maps an id back to its packed name.
+struct Network {
+    std::vector<Direction> instructions;
+    std::vector<std::array<uint32_t, 2U>> nodes;
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> idByKey = std::vector<uint32_t>(NAME_KEY_COUNT, NO_NODE);
 };
 
-auto parse(const std::filesystem::path& filePath) {
-    static constexpr std::size_t BUFFER_SIZE = 10000;
+// Packs a three character name of digits and uppercase letters into a base-36 key below NAME_KEY_COUNT.
+uint32_t packName(const std::string_view name) {
+    if (name.size() != NAME_LENGTH) {
+        throw std::logic_error("Invalid node name");
+    }
 
+    uint32_t key{0U};
+    for (const auto c : name) {
+        uint32_t digit{0U};
+        if (c >= '0' && c <= '9') {
+            digit = static_cast<uint32_t>(c - '0');
+        } else if (c >= 'A' && c <= 'Z') {
+            digit = static_cast<uint32_t>(c - 'A') + 10U;
+        } else {
+            throw std::logic_error("Invalid node name");
+        }
+        key = key * NAME_RADIX + digit;
+    }
+    return key;
+}
+
+char lastLetter(const uint32_t key) {
+    const auto digit = key % NAME_RADIX;
+    return static_cast<char>(digit < 10U ? '0' + digit : 'A' + (digit - 10U));
+}
+
+uint32_t internNode(Network& network, const std::string_view name) {
+    const auto key = packName(name);
+    auto& id = network.idByKey[key];
+    if (id == NO_NODE) {
+        id = static_cast<uint32_t>(network.nodes.size());
+        network.nodes.push_back({NO_NODE, NO_NODE});
+        network.keys.push_back(key);
+    }
+    return id;
+}
+
+auto parse(const std::filesystem::path& filePath) {
     Network input;
-    input.nodes.reserve(BUFFER_SIZE);
     const auto lineCallback = [&input](const std::string& line) {
         if (line.length() == 0U) {
             return;
         }
 
-        if (line.find("=") == std::string::npos) {
-            input.instructions = line;
+        if (line.find('=') == std::string::npos) {
+            for (const auto c : line) {
+                if (c == 'L') {
+                    input.instructions.push_back(LEFT);
+                } else if (c == 'R') {
+                    input.instructions.push_back(RIGHT);
+                } else {
+                    throw std::logic_error("Invalid direction");
+                }
+            }
         } else {
-            const auto parts = split(line, "=");
-            const auto nodeParts = split(trim(parts.back()), ",");
-            input.nodes.insert(
-                {trim(parts.front()), Module{trim(nodeParts.front().substr(1U)),
-                                           trim(nodeParts.back().substr(0U, nodeParts.back().length() - 1U))}});
+            // "AAA = (BBB, CCC)"
+            static constexpr std::size_t LINE_LENGTH = 16U;
+            static constexpr std::size_t LEFT_POS = 7U;
+            static constexpr std::size_t RIGHT_POS = 12U;
+            if (line.length() != LINE_LENGTH) {
+                throw std::logic_error("Invalid line format");
+            }
+
+            const std::string_view view{line};
+            const auto id = internNode(input, view.substr(0U, NAME_LENGTH));
+            const auto left = internNode(input, view.substr(LEFT_POS, NAME_LENGTH));
+            const auto right = internNode(input, view.substr(RIGHT_POS, NAME_LENGTH));
+            input.nodes[id] = {left, right};
         }
     };
     parseInput(filePath, lineCallback);
+
+    if (std::any_of(input.nodes.cbegin(), input.nodes.cend(), [](const auto& node) { return node[LEFT] == NO_NODE; })) {
+        throw std::logic_error("Undefined node");
+    }
     return input;
 }
 
-uint64_t calculatePartOne(const Network& input) {
-    uint64_t result{0U};
-    uint64_t currentStep{0U};
-    std::string currentNodeName{"AAA"};
-    const Module* currentNode{&input.nodes.at(currentNodeName)};
-
-    while (currentNodeName != "ZZZ") {
-        const auto direction = input.instructions.at(currentStep);
-        if (direction == 'R') {
-            currentNodeName = currentNode->right;
-        } else if (direction == 'L') {
-            currentNodeName = currentNode->left;
-        } else {
-            throw std::logic_error("Invalid direction");
-        }
-        currentNode = &input.nodes.at(currentNodeName);
+// For every node: where one full pass over the instructions ends when starting there at the first instruction, and
+// after which steps of that pass (1 to pass length) an end node is reached. Hits are stored CSR-style.
+struct PassTable {
+    std::vector<uint32_t> jump;
+    std::vector<std::size_t> hitBegin;
+    std::vector<uint32_t> hitSteps;
+};
+
+PassTable buildPassTable(const Network& network, const std::vector<bool>& isEndNode) {
+    const auto nodeCount = network.nodes.size();
 
-        ++result;
-        ++currentStep;
-        if (currentStep >= input.instructions.size()) {
-            currentStep = 0U;
+    PassTable table;
+    table.jump.resize(nodeCount);
+    table.hitBegin.reserve(nodeCount + 1U);
+    for (uint32_t start = 0U; start < nodeCount; ++start) {
+        table.hitBegin.push_back(table.hitSteps.size());
+        auto node = start;
+        for (uint32_t step = 0U; step < network.instructions.size(); ++step) {
+            node = network.nodes[node][network.instructions[step]];
+            if (isEndNode[node]) {
+                table.hitSteps.push_back(step + 1U);
+            }
         }
+        table.jump[start] = node;
     }
+    table.hitBegin.push_back(table.hitSteps.size());
+    return table;
+}
 
-    return result;
+// Times at which a single walker stands on an end node. From `cycleStart` on the walk repeats every `cycleLength`
+// steps; `cycleHits` holds the hits of one period as times in [cycleStart, cycleStart + cycleLength).
+struct WalkCycle {
+    std::vector<uint64_t> prefixHits;
+    uint64_t cycleStart;
+    uint64_t cycleLength;
+    std::vector<uint64_t> cycleHits;
+};
+
+bool isAtEnd(const WalkCycle& cycle, const uint64_t time) {
+    if (time < cycle.cycleStart) {
+        return std::binary_search(cycle.prefixHits.cbegin(), cycle.prefixHits.cend(), time);
+    }
+    const auto cycleTime = cycle.cycleStart + (time - cycle.cycleStart) % cycle.cycleLength;
+    return std::binary_search(cycle.cycleHits.cbegin(), cycle.cycleHits.cend(), cycleTime);
 }
 
-uint64_t calculatePartTwo(const Network& input) {
-    std::vector<std::string> nodeNames;
-    for (const auto& elem : input.nodes) {
-        if (elem.first.back() == 'A') {
-            nodeNames.push_back(elem.first);
-        }
+// Walks whole instruction passes through the jump table until a pass starts on an already seen node, so at most one
+// jump per node is needed to find the cycle.
+WalkCycle findWalkCycle(const PassTable& table, const uint32_t startNode, const uint64_t passLength) {
+    static constexpr uint32_t NOT_SEEN = std::numeric_limits<uint32_t>::max();
+
+    std::vector<uint32_t> passOfNode(table.jump.size(), NOT_SEEN);
+    std::vector<uint32_t> passStarts;
+    auto node = startNode;
+    while (passOfNode[node] == NOT_SEEN) {
+        passOfNode[node] = static_cast<uint32_t>(passStarts.size());
+        passStarts.push_back(node);
+        node = table.jump[node];
     }
-    std::vector<uint64_t> results;
-    for (const auto& nodeName : nodeNames) {
-        uint64_t result{0U};
-        uint64_t currentStep{0U};
-        std::string currentNodeName{nodeName};
-        const Module* currentNode{&input.nodes.at(currentNodeName)};
-
-        while (currentNodeName.back() != 'Z') {
-            const auto direction = input.instructions.at(currentStep);
-            if (direction == 'R') {
-                currentNodeName = currentNode->right;
-            } else if (direction == 'L') {
-                currentNodeName = currentNode->left;
-            } else {
-                throw std::logic_error("Invalid direction");
-            }
-            currentNode = &input.nodes.at(currentNodeName);
 
-            ++result;
-            ++currentStep;
-            if (currentStep >= input.instructions.size()) {
-                currentStep = 0U;
+    WalkCycle cycle{{}, passOfNode[node] * passLength, (passStarts.size() - passOfNode[node]) * passLength, {}};
+    for (std::size_t pass = 0U; pass < passStarts.size(); ++pass) {
+        const auto passNode = passStarts[pass];
+        for (auto hit = table.hitBegin[passNode]; hit < table.hitBegin[passNode + 1U]; ++hit) {
+            const auto time = pass * passLength + table.hitSteps[hit];
+            if (time < cycle.cycleStart) {
+                cycle.prefixHits.push_back(time);
+            } else {
+                cycle.cycleHits.push_back(cycle.cycleStart + (time - cycle.cycleStart) % cycle.cycleLength);
             }
         }
-        results.push_back(result);
     }
+    std::sort(cycle.cycleHits.begin(), cycle.cycleHits.end());
+    cycle.cycleHits.erase(std::unique(cycle.cycleHits.begin(), cycle.cycleHits.end()), cycle.cycleHits.end());
+    return cycle;
+}
+
+struct Congruence {
+    uint64_t remainder;
+    uint64_t modulus;
+};
+
+uint64_t addMod(const uint64_t a, const uint64_t b, const uint64_t modulus) {
+    return a >= modulus - b ? a - (modulus - b) : a + b;
+}
+
+uint64_t mulMod(uint64_t a, uint64_t b, const uint64_t modulus) {
     uint64_t result{0U};
-    for (const auto r : results) {
-        if (result == 0U) {
-            result = r;
-        } else {
-            result = std::lcm(result, r);
+    a %= modulus;
+    while (b > 0U) {
+        if ((b & 1U) != 0U) {
+            result = addMod(result, a, modulus);
         }
+        a = addMod(a, a, modulus);
+        b >>= 1U;
     }
     return result;
 }
+
+uint64_t modInverse(const uint64_t value, const uint64_t modulus) {
+    int64_t oldR = static_cast<int64_t>(value % modulus);
+    int64_t r = static_cast<int64_t>(modulus);
+    int64_t oldS = 1;
+    int64_t s = 0;
+    while (r != 0) {
+        const auto quotient = oldR / r;
+        oldR = std::exchange(r, oldR - quotient * r);
+        oldS = std::exchange(s, oldS - quotient * s);
+    }
+    return static_cast<uint64_t>((oldS % static_cast<int64_t>(modulus) + static_cast<int64_t>(modulus)) %
+                                 static_cast<int64_t>(modulus));
+}
+
+// Generalised CRT for moduli that need not be coprime.
+std::optional<Congruence> combine(const Congruence& a, const Congruence& b) {
+    const auto divisor = std::gcd(a.modulus, b.modulus);
+    const auto difference = addMod(b.remainder % b.modulus, b.modulus - a.remainder % b.modulus, b.modulus);
+    if (difference % divisor != 0U) {
+        return {};
+    }
+
+    const auto reducedModulus = b.modulus / divisor;
+    if (a.modulus / divisor > std::numeric_limits<uint64_t>::max() / b.modulus) {
+        throw std::overflow_error("Combined cycle length does not fit into 64 bits");
+    }
+    const auto modulus = a.modulus / divisor * b.modulus;
+    const auto factor = mulMod(difference / divisor, modInverse(a.modulus / divisor, reducedModulus), reducedModulus);
+    return Congruence{addMod(a.remainder, a.modulus * factor, modulus), modulus};
+}
+
+// Narrows the common arrivals of the walks combined so far down to those where `walk` is on an end node as well. All
+// arrivals share one modulus, the lcm of the cycle lengths so far, so they are kept unique by remainder. An arrival can
+// only pair with hits that agree with it modulo the gcd of both cycle lengths, so hits are looked up by that residue
+// rather than trying every pair, and the candidate count is capped in case the cycles still multiply it out.
+std::vector<Congruence> combineArrivals(const std::vector<Congruence>& arrivals, const WalkCycle& walk) {
+    static constexpr std::size_t MAX_ARRIVAL_COUNT = 1U << 20U;
+
+    const auto divisor = std::gcd(arrivals.front().modulus, walk.cycleLength);
+    std::vector<std::pair<uint64_t, uint64_t>> hitsByResidue;
+    hitsByResidue.reserve(walk.cycleHits.size());
+    for (const auto hit : walk.cycleHits) {
+        hitsByResidue.emplace_back(hit % divisor, hit % walk.cycleLength);
+    }
+    std::sort(hitsByResidue.begin(), hitsByResidue.end());
+
+    std::vector<Congruence> combined;
+    for (const auto& arrival : arrivals) {
+        const auto matching = std::ranges::equal_range(hitsByResidue, arrival.remainder % divisor, {},
+                                                       &std::pair<uint64_t, uint64_t>::first);
+        for (const auto& [residue, hit] : matching) {
+            if (const auto congruence = combine(arrival, {hit, walk.cycleLength})) {
+                combined.push_back(*congruence);
+            }
+        }
+    }
+
+    std::sort(combined.begin(), combined.end(),
+              [](const Congruence& lhs, const Congruence& rhs) { return lhs.remainder < rhs.remainder; });
+    combined.erase(std::unique(combined.begin(), combined.end(),
+                               [](const Congruence& lhs, const Congruence& rhs) {
+                                   return lhs.remainder == rhs.remainder;
+                               }),
+                   combined.end());
+    if (combined.size() > MAX_ARRIVAL_COUNT) {
+        throw std::overflow_error("Too many candidate arrival times");
+    }
+    return combined;
+}
+
+uint64_t findFirstCommonArrival(const std::vector<WalkCycle>& walks) {
+    if (walks.empty()) {
+        throw std::logic_error("No walkers");
+    }
+
+    const auto allCyclingFrom = std::max<uint64_t>(
+        1U, std::max_element(walks.cbegin(), walks.cend(), [](const auto& lhs, const auto& rhs) {
+                return lhs.cycleStart < rhs.cycleStart;
+            })->cycleStart);
+
+    // Before every walk is on its cycle, a common arrival has to be a prefix hit of at least one walk.
+    std::vector<uint64_t> candidates;
+    for (const auto& walk : walks) {
+        candidates.insert(candidates.end(), walk.prefixHits.cbegin(), walk.prefixHits.cend());
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto time : candidates) {
+        if (std::all_of(walks.cbegin(), walks.cend(), [time](const auto& walk) { return isAtEnd(walk, time); })) {
+            return time;
+        }
+    }
+
+    // Walks with few arrivals per cycle go first so the candidate set stays small for as long as possible.
+    std::vector<const WalkCycle*> byHitCount;
+    for (const auto& walk : walks) {
+        byHitCount.push_back(&walk);
+    }
+    std::sort(byHitCount.begin(), byHitCount.end(),
+              [](const auto* lhs, const auto* rhs) { return lhs->cycleHits.size() < rhs->cycleHits.size(); });
+
+    std::vector<Congruence> arrivals{{0U, 1U}};
+    for (const auto* walk : byHitCount) {
+        arrivals = combineArrivals(arrivals, *walk);
+        if (arrivals.empty()) {
+            break;
+        }
+    }
+
+    std::optional<uint64_t> result;
+    for (const auto& arrival : arrivals) {
+        auto time = arrival.remainder;
+        if (time < allCyclingFrom) {
+            time += (allCyclingFrom - time + arrival.modulus - 1U) / arrival.modulus * arrival.modulus;
+        }
+        if (!result.has_value() || time < *result) {
+            result = time;
+        }
+    }
+    if (!result.has_value()) {
+        throw std::logic_error("Walkers never arrive at the same time");
+    }
+    return *result;
+}
+
+template <typename NodePredicate>
+std::vector<bool> markNodes(const Network& network, NodePredicate predicate) {
+    std::vector<bool> marked(network.nodes.size());
+    for (std::size_t id = 0U; id < network.nodes.size(); ++id) {
+        marked[id] = predicate(network.keys[id]);
+    }
+    return marked;
+}
+
+uint64_t calculatePartOne(const Network& input) {
+    const auto startNode = input.idByKey[packName("AAA")];
+    const auto endKey = packName("ZZZ");
+    if (startNode == NO_NODE) {
+        throw std::logic_error("Start node not found");
+    }
+
+    const auto table = buildPassTable(input, markNodes(input, [endKey](const uint32_t key) { return key == endKey; }));
+    return findFirstCommonArrival({findWalkCycle(table, startNode, input.instructions.size())});
+}
+
+uint64_t calculatePartTwo(const Network& input) {
+    const auto table =
+        buildPassTable(input, markNodes(input, [](const uint32_t key) { return lastLetter(key) == 'Z'; }));
+
+    std::vector<std::future<WalkCycle>> futures;
+    for (uint32_t id = 0U; id < input.nodes.size(); ++id) {
+        if (lastLetter(input.keys[id]) == 'A') {
+            futures.push_back(std::async(std::launch::async, [&table, &input, id]() {
+                return findWalkCycle(table, id, input.instructions.size());
+            }));
+        }
+    }
+
+    std::vector<WalkCycle> walks;
+    walks.reserve(futures.size());
+    for (auto& future : futures) {
+        walks.push_back(future.get());
+    }
+    return findFirstCommonArrival(walks);
+}
 }  // namespace
 
 std::pair<std::string, std::string> day08() {
@@ -2,6 +2,7 @@
 
 #include "bblp/aoc/file_utils.hpp"
 #include "bblp/aoc/point.hpp"
+#include "bblp/aoc/polygon.hpp"
 #include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
@@ -29,8 +30,6 @@ enum class TileType : uint8_t {
     STARTING_POSITION
 };
 
-enum class LoopMembershipType : uint8_t { UNKNOWN, PART_OF_LOOP, INSIDE_OF_LOOP, OUTSIDE_OF_LOOP };
-
 TileType charToTileType(const char c) {
     switch (c) {
         case '.':
@@ -148,184 +147,21 @@ uint64_t calculatePartOne(const std::vector<std::vector<TileType>>& input) {
     return result / 2U;
 }
 
-void markRouteAsPartOfLoop(std::vector<std::vector<LoopMembershipType>>& loopMembership,
-                           const Point& currentPosition,
-                           const Point& previousPosition) {
-    loopMembership.at(2 * currentPosition.y).at(2 * currentPosition.x) = LoopMembershipType::PART_OF_LOOP;
-
-    const auto yDiff = currentPosition.y - previousPosition.y;
-    if (yDiff > 0) {
-        loopMembership.at(2 * currentPosition.y - 1).at(2 * currentPosition.x) = LoopMembershipType::PART_OF_LOOP;
-    } else if (yDiff < 0) {
-        loopMembership.at(2 * currentPosition.y + 1).at(2 * currentPosition.x) = LoopMembershipType::PART_OF_LOOP;
-    }
-
-    const auto xDiff = currentPosition.x - previousPosition.x;
-    if (xDiff > 0) {
-        loopMembership.at(2 * currentPosition.y).at(2 * currentPosition.x - 1) = LoopMembershipType::PART_OF_LOOP;
-    } else if (xDiff < 0) {
-        loopMembership.at(2 * currentPosition.y).at(2 * currentPosition.x + 1) = LoopMembershipType::PART_OF_LOOP;
-    }
-}
-
-int64_t findNumberOfLoopPartsAbove(const std::vector<std::vector<LoopMembershipType>>& loopMembership,
-                                   const Point& point) {
-    int64_t result{0};
-    Point currentPoint{point};
-    while (currentPoint.y >= 0) {
-        const auto type = loopMembership.at(currentPoint.y).at(currentPoint.x);
-        if (type == LoopMembershipType::PART_OF_LOOP) {
-            ++result;
-        }
-        --currentPoint.y;
-    }
-    return result;
-}
-
-int64_t findNumberOfLoopPartsBelow(const std::vector<std::vector<LoopMembershipType>>& loopMembership,
-                                   const Point& point) {
-    int64_t result{0};
-    Point currentPoint{point};
-    while (currentPoint.y < loopMembership.size()) {
-        const auto type = loopMembership.at(currentPoint.y).at(currentPoint.x);
-        if (type == LoopMembershipType::PART_OF_LOOP) {
-            ++result;
-        }
-        ++currentPoint.y;
-    }
-    return result;
-}
-
-int64_t findNumberOfLoopPartsLeft(const std::vector<std::vector<LoopMembershipType>>& loopMembership,
-                                  const Point& point) {
-    int64_t result{0};
-    Point currentPoint{point};
-    while (currentPoint.x >= 0) {
-        const auto type = loopMembership.at(currentPoint.y).at(currentPoint.x);
-        if (type == LoopMembershipType::PART_OF_LOOP) {
-            ++result;
-        }
-        --currentPoint.x;
-    }
-    return result;
-}
-
-int64_t findNumberOfLoopPartsRight(const std::vector<std::vector<LoopMembershipType>>& loopMembership,
-                                   const Point& point) {
-    int64_t result{0};
-    Point currentPoint{point};
-    while (currentPoint.x < loopMembership.at(currentPoint.y).size()) {
-        const auto type = loopMembership.at(currentPoint.y).at(currentPoint.x);
-        if (type == LoopMembershipType::PART_OF_LOOP) {
-            ++result;
-        }
-        ++currentPoint.x;
-    }
-    return result;
-}
-
-void markOutsideTilesAsNotPartOfLoop(std::vector<std::vector<LoopMembershipType>>& loopMembership) {
-    for (auto y = 0U; y < loopMembership.size(); ++y) {
-        for (auto x = 0U; x < loopMembership.at(y).size(); ++x) {
-            const auto part = loopMembership.at(y).at(x);
-            if (part == LoopMembershipType::PART_OF_LOOP) {
-                continue;
-            }
-
-            const auto loopPartsAbove = findNumberOfLoopPartsAbove(loopMembership, {x, y});
-            const auto loopPartsBelow = findNumberOfLoopPartsBelow(loopMembership, {x, y});
-            const auto loopPartsLeft = findNumberOfLoopPartsLeft(loopMembership, {x, y});
-            const auto loopPartsRight = findNumberOfLoopPartsRight(loopMembership, {x, y});
-
-            if (loopPartsAbove == 0 || loopPartsBelow == 0 || loopPartsLeft == 0 || loopPartsRight == 0) {
-                loopMembership.at(y).at(x) = LoopMembershipType::OUTSIDE_OF_LOOP;
-            }
-        }
-    }
-}
-
-void fillFromOutside(std::vector<std::vector<LoopMembershipType>>& loopMembership) {
-    int64_t numberChanged{0};
-    do {
-        numberChanged = 0;
-        for (auto y = 0U; y < loopMembership.size(); ++y) {
-            for (auto x = 0U; x < loopMembership.at(y).size(); ++x) {
-                if (loopMembership.at(y).at(x) != LoopMembershipType::OUTSIDE_OF_LOOP) {
-                    continue;
-                }
-
-                if (x > 0) {
-                    const Point next{x - 1, y};
-                    if (loopMembership.at(next.y).at(next.x) == LoopMembershipType::UNKNOWN) {
-                        loopMembership.at(next.y).at(next.x) = LoopMembershipType::OUTSIDE_OF_LOOP;
-                        ++numberChanged;
-                    }
-                }
-                if (x < loopMembership.at(y).size() - 1) {
-                    const Point next{x + 1, y};
-                    if (loopMembership.at(next.y).at(next.x) == LoopMembershipType::UNKNOWN) {
-                        loopMembership.at(next.y).at(next.x) = LoopMembershipType::OUTSIDE_OF_LOOP;
-                        ++numberChanged;
-                    }
-                }
-                if (y > 0) {
-                    const Point next{x, y - 1};
-                    if (loopMembership.at(next.y).at(next.x) == LoopMembershipType::UNKNOWN) {
-                        loopMembership.at(next.y).at(next.x) = LoopMembershipType::OUTSIDE_OF_LOOP;
-                        ++numberChanged;
-                    }
-                }
-                if (y < loopMembership.size() - 1) {
-                    const Point next{x, y + 1};
-                    if (loopMembership.at(next.y).at(next.x) == LoopMembershipType::UNKNOWN) {
-                        loopMembership.at(next.y).at(next.x) = LoopMembershipType::OUTSIDE_OF_LOOP;
-                        ++numberChanged;
-                    }
-                }
-            }
-        }
-    } while (numberChanged != 0);
-}
-
-void markTilesInsideOfLoop(std::vector<std::vector<LoopMembershipType>>& loopMembership) {
-    for (auto y = 0U; y < loopMembership.size() / 2; ++y) {
-        for (auto x = 0U; x < loopMembership.at(y).size() / 2; ++x) {
-            if (loopMembership.at(2 * y).at(2 * x) == LoopMembershipType::UNKNOWN) {
-                loopMembership.at(2 * y).at(2 * x) = LoopMembershipType::INSIDE_OF_LOOP;
-            }
-        }
-    }
-}
-
+// The loop tiles are the lattice points on the boundary of a polygon, so Pick's theorem yields the enclosed tiles.
 int64_t calculatePartTwo(const std::vector<std::vector<TileType>>& input) {
-    std::vector<std::vector<LoopMembershipType>> loopMembership(
-        input.size() * 2, std::vector<LoopMembershipType>(input.front().size() * 2));
-
     const auto startingPosition = findStartingPosition(input);
-    const auto availableStartingMoves = findAvailableMoves(input, startingPosition);
     auto previousPosition = startingPosition;
     auto currentPosition = startingPosition;
+    LatticePolygon loop{startingPosition};
 
     do {
-        markRouteAsPartOfLoop(loopMembership, currentPosition, previousPosition);
         const auto nextPosition = moveToNextTile(input, previousPosition, currentPosition);
         previousPosition = currentPosition;
         currentPosition = nextPosition;
+        loop.moveTo(currentPosition);
     } while (input.at(currentPosition.y).at(currentPosition.x) != TileType::STARTING_POSITION);
 
-    markRouteAsPartOfLoop(loopMembership, currentPosition, previousPosition);
-    markOutsideTilesAsNotPartOfLoop(loopMembership);
-    fillFromOutside(loopMembership);
-    markTilesInsideOfLoop(loopMembership);
-
-    return std::accumulate(
-        loopMembership.cbegin(), loopMembership.cend(), 0LL,
-        [](int64_t sum, const std::vector<LoopMembershipType>& row) {
-            return sum +
-                   std::accumulate(row.cbegin(), row.cend(), 0LL, [](int64_t rowSum, const LoopMembershipType type) {
-                       return rowSum + (type == LoopMembershipType::INSIDE_OF_LOOP ? 1 : 0);
-                   });
-        });
+    return loop.interiorPoints();
 }
 }  // namespace
 
@@ -1,30 +1,50 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/point.hpp"
-#include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
-#include <array>
+#include <bit>
+#include <cstdint>
 #include <cstdlib>
-#include <fstream>
 #include <future>
-#include <iostream>
 #include <numeric>
 #include <optional>
-#include <set>
 #include <stdexcept>
-#include <string_view>
 #include <thread>
-#include <unordered_map>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
+constexpr char ROCK{'#'};
+constexpr std::size_t MAX_LANDSCAPE_SIZE = 64U;
+
+// Each row and each column is stored as a bitmask of rocks, so two lines differ in popcount(a ^ b) positions.
 struct Landscape {
-    std::vector<std::string> pattern;
+    std::vector<uint64_t> rows;
+    std::vector<uint64_t> cols;
 };
 
+void addRow(Landscape& landscape, const std::string& line) {
+    if (line.size() > MAX_LANDSCAPE_SIZE || landscape.rows.size() >= MAX_LANDSCAPE_SIZE) {
+        throw std::out_of_range("Landscape too large");
+    }
+    if (landscape.cols.empty()) {
+        landscape.cols.resize(line.size(), 0U);
+    } else if (landscape.cols.size() != line.size()) {
+        throw std::logic_error("Inconsistent landscape width");
+    }
+
+    const auto y = landscape.rows.size();
+    uint64_t row{0U};
+    for (std::size_t x = 0U; x < line.size(); ++x) {
+        if (line[x] == ROCK) {
+            row |= 1ULL << x;
+            landscape.cols[x] |= 1ULL << y;
+        }
+    }
+    landscape.rows.push_back(row);
+}
+
 auto parse(const std::filesystem::path& filePath) {
     std::vector<Landscape> input;
 
@@ -33,91 +53,38 @@ auto parse(const std::filesystem::path& filePath) {
         if (line.empty()) {
             input.push_back(Landscape{});
         } else {
-            input.back().pattern.push_back(line);
+            addRow(input.back(), line);
         }
     };
     parseInput(filePath, lineCallback);
-    return input;
-}
 
-uint32_t isVerticalPattern(const Landscape& landscape, Point coords) {
-    uint32_t diffs{0U};
-    for (auto k = 0U; k < landscape.pattern.size(); ++k) {
-        if (landscape.pattern.at(k).at(coords.x) != landscape.pattern.at(k).at(coords.y)) {
-            ++diffs;
-        }
-    }
-    return diffs;
-}
-
-bool isVerticalPattern(const Landscape& landscape, uint32_t i, uint32_t allowedDiffs) {
-    uint32_t totalDiffs{0U};
-    for (int32_t j = 0; j <= i; j++) {
-        const auto leftIndex = i - j;
-        const auto rightIndex = i + 1 + j;
-        if (leftIndex < 0 || rightIndex >= landscape.pattern.front().size()) {
-            break;
-        }
-
-        totalDiffs += isVerticalPattern(landscape, Point{leftIndex, rightIndex});
-        if (totalDiffs > allowedDiffs) {
-            return false;
-        }
-    }
-    return totalDiffs == allowedDiffs;
-}
-
-uint32_t isHorizontalPattern(const Landscape& landscape, Point coords) {
-    uint32_t diffs{0U};
-    for (auto k = 0U; k < landscape.pattern.front().size(); ++k) {
-        if (landscape.pattern.at(coords.x).at(k) != landscape.pattern.at(coords.y).at(k)) {
-            ++diffs;
-        }
+    if (input.back().rows.empty()) {
+        input.pop_back();
     }
-    return diffs;
-}
-
-bool isHorizontalPattern(const Landscape& landscape, uint32_t i, uint32_t allowedDiffs) {
-    uint32_t totalDiffs{0U};
-    for (int32_t j = 0; j <= i; j++) {
-        const auto topIndex = i - j;
-        const auto bottomIndex = i + 1 + j;
-        if (topIndex < 0 || bottomIndex >= landscape.pattern.size()) {
-            break;
-        }
-
-        totalDiffs += isHorizontalPattern(landscape, Point{topIndex, bottomIndex});
-        if (totalDiffs > allowedDiffs) {
-            return false;
-        }
-    }
-    return totalDiffs == allowedDiffs;
+    return input;
 }
 
-std::optional<uint64_t> findVerticalPattern(const Landscape& landscape, uint32_t allowedDiffs) {
-    for (auto i = 0U; i < landscape.pattern.front().size() - 1; ++i) {
-        if (isVerticalPattern(landscape, i, allowedDiffs)) {
-            return i + 1;
+// Returns the number of lines before the first mirror whose two sides differ in exactly `smudges` positions.
+std::optional<uint64_t> findReflection(const std::vector<uint64_t>& lines, const uint32_t smudges) {
+    for (std::size_t mirror = 1U; mirror < lines.size(); ++mirror) {
+        uint32_t diffs{0U};
+        for (std::size_t before = mirror, after = mirror; before > 0U && after < lines.size() && diffs <= smudges;
+             --before, ++after) {
+            diffs += static_cast<uint32_t>(std::popcount(lines[before - 1U] ^ lines[after]));
         }
-    }
-    return {};
-}
-
-std::optional<uint64_t> findHorizontalPattern(const Landscape& landscape, uint32_t allowedDiffs) {
-    for (auto i = 0U; i < landscape.pattern.size() - 1; ++i) {
-        if (isHorizontalPattern(landscape, i, allowedDiffs)) {
-            return i + 1;
+        if (diffs == smudges) {
+            return mirror;
         }
     }
     return {};
 }
 
-uint64_t calculateReflectionPattern(const Landscape& landscape, uint32_t allowedDiffs) {
-    const auto verticalPattern = findVerticalPattern(landscape, allowedDiffs);
+uint64_t calculateReflectionPattern(const Landscape& landscape, const uint32_t smudges) {
+    const auto verticalPattern = findReflection(landscape.cols, smudges);
     if (verticalPattern) {
         return *verticalPattern;
     } else {
-        const auto horizontalPattern = findHorizontalPattern(landscape, allowedDiffs);
+        const auto horizontalPattern = findReflection(landscape.rows, smudges);
         if (horizontalPattern) {
             return *horizontalPattern * 100ULL;
         } else {
@@ -126,16 +93,39 @@ uint64_t calculateReflectionPattern(const Landscape& landscape, uint32_t allowed
     }
 }
 
+// Landscapes are independent, so they are summed in one contiguous chunk per hardware thread.
+uint64_t summarizeReflections(const std::vector<Landscape>& input, const uint32_t smudges) {
+    if (input.empty()) {
+        return 0U;
+    }
+
+    const auto summarize = [&input, smudges](std::size_t begin, std::size_t end) {
+        return std::accumulate(input.cbegin() + begin, input.cbegin() + end, static_cast<uint64_t>(0U),
+                               [smudges](uint64_t sum, const Landscape& landscape) {
+                                   return sum + calculateReflectionPattern(landscape, smudges);
+                               });
+    };
+
+    const std::size_t chunkCount = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1U, input.size());
+    const auto chunkSize = (input.size() + chunkCount - 1U) / chunkCount;
+    std::vector<std::future<uint64_t>> futures;
+    for (std::size_t begin = chunkSize; begin < input.size(); begin += chunkSize) {
+        futures.push_back(std::async(std::launch::async, summarize, begin, std::min(begin + chunkSize, input.size())));
+    }
+
+    auto result = summarize(0U, std::min(chunkSize, input.size()));
+    for (auto& future : futures) {
+        result += future.get();
+    }
+    return result;
+}
+
 uint64_t calculatePartOne(const std::vector<Landscape>& input) {
-    return std::accumulate(input.cbegin(), input.cend(), 0ULL, [](uint64_t sum, const Landscape& landscape) {
-        return sum + calculateReflectionPattern(landscape, 0U);
-    });
+    return summarizeReflections(input, 0U);
 }
 
 uint64_t calculatePartTwo(const std::vector<Landscape>& input) {
-    return std::accumulate(input.cbegin(), input.cend(), 0ULL, [](uint64_t sum, const Landscape& landscape) {
-        return sum + calculateReflectionPattern(landscape, 1U);
-    });
+    return summarizeReflections(input, 1U);
 }
 }  // namespace
 
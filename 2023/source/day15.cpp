@@ -1,118 +1,179 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/point.hpp"
-#include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <cstdlib>
-#include <fstream>
-#include <future>
-#include <iostream>
+#include <limits>
 #include <numeric>
-#include <optional>
-#include <set>
 #include <stdexcept>
 #include <string_view>
-#include <thread>
 #include <unordered_map>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
+// Comma-separated steps kept in one buffer; each step is a view into it. Steps of later lines come first.
+class InitializationSequence {
+  public:
+    void addLine(const std::string_view line) {
+        std::vector<std::pair<std::size_t, std::size_t>> lineSteps;
+        std::size_t start = 0U;
+        while (true) {
+            const auto end = std::min(line.find(',', start), line.size());
+            lineSteps.emplace_back(mText.size() + start, end - start);
+            if (end == line.size()) {
+                break;
+            }
+            start = end + 1U;
+        }
+        mText.append(line);
+        mSteps.insert(mSteps.begin(), lineSteps.cbegin(), lineSteps.cend());
+    }
+
+    [[nodiscard]] std::size_t size() const { return mSteps.size(); }
+
+    [[nodiscard]] std::string_view at(const std::size_t index) const {
+        return std::string_view(mText).substr(mSteps[index].first, mSteps[index].second);
+    }
+
+  private:
+    std::string mText;
+    std::vector<std::pair<std::size_t, std::size_t>> mSteps;
+};
+
 auto parse(const std::filesystem::path& filePath) {
-    std::vector<std::string> input;
+    InitializationSequence input;
 
-    const auto lineCallback = [&input](const std::string& line) {
-        const auto parts = split(line, ",");
-        input.insert(input.begin(), parts.cbegin(), parts.cend());
-    };
+    const auto lineCallback = [&input](const std::string& line) { input.addLine(line); };
     parseInput(filePath, lineCallback);
     return input;
 }
 
-uint8_t calculateHash(const std::string& str) {
+static constexpr std::size_t BOX_COUNT = 256U;
+static constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+static constexpr uint8_t EMPTY_SLOT = 0U;
+
+uint8_t calculateHash(const std::string_view str) {
     uint8_t hash{0U};
     for (const auto c : str) {
-        hash += c;
-        hash *= 17;
+        hash = static_cast<uint8_t>((hash + static_cast<uint8_t>(c)) * 17U);
     }
     return hash;
 }
 
-
-uint64_t calculatePartOne(const std::vector<std::string>& input) {
-    return std::accumulate(input.cbegin(), input.cend(), 0ULL,
-                           [](uint64_t sum, const std::string& str) { return sum + calculateHash(str); });
+uint64_t calculatePartOne(const InitializationSequence& input) {
+    uint64_t sum{0U};
+    for (std::size_t i = 0U; i < input.size(); ++i) {
+        sum += calculateHash(input.at(i));
+    }
+    return sum;
 }
 
-std::ostream& operator<<(std::ostream& stream, const std::array<std::vector<std::string>, 256>& boxes) {
-    for (auto i = 0U; i < boxes.size(); ++i) {
-        if (boxes.at(i).size() == 0U) {
-            continue;
+// Lenses are kept in insertion order; a removed lens leaves a slot with EMPTY_SLOT focal length behind instead of
+// shifting the rest of the box, and the box is compacted once the tombstones outnumber the lenses.
+struct Lens {
+    uint32_t labelId;
+    uint8_t focalLength;
+};
+
+struct Box {
+    std::vector<Lens> slots;
+    std::size_t lensCount{0U};
+};
+
+class LensBoxes {
+  public:
+    void insert(const std::string_view label, const uint8_t focalLength) {
+        const auto labelId = internLabel(label);
+        auto& slot = mSlotOfLabel[labelId];
+        auto& box = mBoxes[mBoxOfLabel[labelId]];
+        if (slot != NO_SLOT) {
+            box.slots[slot].focalLength = focalLength;
+        } else {
+            slot = static_cast<uint32_t>(box.slots.size());
+            box.slots.push_back(Lens{labelId, focalLength});
+            ++box.lensCount;
+        }
+    }
+
+    void remove(const std::string_view label) {
+        const auto labelId = internLabel(label);
+        auto& slot = mSlotOfLabel[labelId];
+        if (slot == NO_SLOT) {
+            return;
         }
 
-        stream << "Box " << i << ":";
-        for (const auto& str : boxes.at(i)) {
-            stream << " [" << str << "]";
+        auto& box = mBoxes[mBoxOfLabel[labelId]];
+        box.slots[slot].focalLength = EMPTY_SLOT;
+        slot = NO_SLOT;
+        --box.lensCount;
+        if (box.slots.size() > 2U * box.lensCount) {
+            compact(box);
         }
-        stream << '\n';
     }
-    return stream;
-}
 
-uint64_t calculatePartTwo(const std::vector<std::string>& input) {
-    std::array<std::vector<std::string>, 256> boxes{};
-    for (const auto& str : input) {
-        if (str.find('-') != std::string::npos) {
-            const auto parts = split(str, "-");
-            const auto& label = parts.front();
-            const auto hash = calculateHash(label);
-            auto& box = boxes.at(hash);
-            if (hash == 214U) {
-                int i = 0;
+    [[nodiscard]] uint64_t calculateFocusingPower() const {
+        uint64_t result{0U};
+        for (std::size_t i = 0U; i < mBoxes.size(); ++i) {
+            uint64_t position{0U};
+            for (const auto& lens : mBoxes[i].slots) {
+                if (lens.focalLength != EMPTY_SLOT) {
+                    result += (i + 1U) * (++position) * lens.focalLength;
+                }
             }
-            const auto iter = std::find_if(box.begin(), box.end(), [&label](const std::string& content) {
-                return content.find(label) != std::string::npos;
-            });
-
-            if (iter != box.end()) {
-                box.erase(iter);
-            }        
-        } else if (str.find('=') != std::string::npos) {
-            const auto parts = split(str, "=");
-            const auto& label = parts.front();
-            const auto& lens = parts.back();
-            const auto hash = calculateHash(label);
-            auto& box = boxes.at(hash);
-            if (hash == 214U) {
-                int i = 0;
-            }
-
-            const auto iter = std::find_if(box.begin(), box.end(), [&label](const std::string& content) {
-                return (label.size() == content.size() - 2U) && (content.find(label) == 0U);
-            });
+        }
+        return result;
+    }
 
-            if (iter != box.end()) {
-                *iter = label + " " + lens;
-            } else {
-                box.push_back(label + " " + lens);
-            }
-        } else {
-            throw std::logic_error("Invalid string");
+  private:
+    uint32_t internLabel(const std::string_view label) {
+        const auto [iter, inserted] = mLabelIds.try_emplace(label, static_cast<uint32_t>(mSlotOfLabel.size()));
+        if (inserted) {
+            mSlotOfLabel.push_back(NO_SLOT);
+            mBoxOfLabel.push_back(calculateHash(label));
         }
+        return iter->second;
     }
-    uint64_t result{0U}, result2{0U};
-    for (auto i = 0U; i < boxes.size(); ++i) {
-        const auto& box = boxes.at(i);
-        for (auto j = 0U; j < box.size(); ++j) {
-            const auto parts = split(box.at(j), " ");
-            result += (i + 1ULL) * (j + 1ULL) * std::stoul(parts.back());
+
+    void compact(Box& box) {
+        const auto lensesEnd = std::remove_if(box.slots.begin(), box.slots.end(),
+                                              [](const Lens& lens) { return lens.focalLength == EMPTY_SLOT; });
+        box.slots.erase(lensesEnd, box.slots.end());
+        for (std::size_t slot = 0U; slot < box.slots.size(); ++slot) {
+            mSlotOfLabel[box.slots[slot].labelId] = static_cast<uint32_t>(slot);
         }
     }
 
-    return result;
+    std::array<Box, BOX_COUNT> mBoxes{};
+    std::unordered_map<std::string_view, uint32_t> mLabelIds;
+    std::vector<uint32_t> mSlotOfLabel;
+    std::vector<uint8_t> mBoxOfLabel;
+};
+
+uint64_t calculatePartTwo(const InitializationSequence& input) {
+    LensBoxes boxes;
+    for (std::size_t i = 0U; i < input.size(); ++i) {
+        const auto view = input.at(i);
+        const auto operationPos = view.find_first_of("-=");
+        if (operationPos == std::string_view::npos) {
+            throw std::logic_error("Invalid string");
+        }
+
+        const auto label = view.substr(0U, operationPos);
+        if (view[operationPos] == '-') {
+            boxes.remove(label);
+        } else {
+            const auto focalLength = view.substr(operationPos + 1U);
+            if (focalLength.size() != 1U || focalLength.front() < '1' || focalLength.front() > '9') {
+                throw std::logic_error("Invalid focal length");
+            }
+            boxes.insert(label, static_cast<uint8_t>(focalLength.front() - '0'));
+        }
+    }
+    return boxes.calculateFocusingPower();
 }
 }  // namespace
 
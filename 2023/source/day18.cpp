@@ -1,42 +1,102 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/point.hpp"
-#include "bblp/aoc/string_utils.hpp"
+#include "bblp/aoc/polygon.hpp"
 
-#include <algorithm>
-#include <array>
+#include <cstdint>
 #include <cstdlib>
-#include <fstream>
-#include <future>
-#include <iostream>
-#include <list>
-#include <numeric>
-#include <optional>
-#include <queue>
-#include <set>
 #include <stdexcept>
-#include <string_view>
-#include <thread>
-#include <unordered_map>
+#include <string>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
+enum class Direction : uint8_t { RIGHT, DOWN, LEFT, UP };
+
+struct DigInstruction {
+    Direction direction;
+    int64_t distance;
+};
+
+// Each line holds two readings of the same step: "R 6 (#70c710)" is R 6 for part one, while the colour encodes the
+// distance in its first five hex digits and the direction in the last one for part two.
+struct DigPlan {
+    std::vector<DigInstruction> plain;
+    std::vector<DigInstruction> encoded;
+};
+
+Direction parseDirection(const char c) {
+    switch (c) {
+        case 'R':
+            return Direction::RIGHT;
+        case 'D':
+            return Direction::DOWN;
+        case 'L':
+            return Direction::LEFT;
+        case 'U':
+            return Direction::UP;
+    }
+    throw std::logic_error("Invalid direction");
+}
+
+DigInstruction parseEncodedInstruction(const std::string& line) {
+    static constexpr std::size_t HEX_DISTANCE_LENGTH = 5U;
+    static constexpr int64_t HEX_DIRECTION_COUNT = 4;
+
+    const auto hashPos = line.find('#');
+    if (hashPos == std::string::npos || line.size() < hashPos + HEX_DISTANCE_LENGTH + 2U) {
+        throw std::logic_error("Invalid line format");
+    }
+
+    const auto distance = std::stoll(line.substr(hashPos + 1U, HEX_DISTANCE_LENGTH), nullptr, 16);
+    const auto direction = line.at(hashPos + HEX_DISTANCE_LENGTH + 1U) - '0';
+    if (direction < 0 || direction >= HEX_DIRECTION_COUNT) {
+        throw std::logic_error("Invalid direction");
+    }
+    return DigInstruction{static_cast<Direction>(direction), distance};
+}
+
 auto parse(const std::filesystem::path& filePath) {
-    std::vector<std::string> input;
+    DigPlan input;
 
-    const auto lineCallback = [&input](const std::string& line) { input.push_back(line); };
+    const auto lineCallback = [&input](const std::string& line) {
+        if (line.size() < 3U) {
+            throw std::logic_error("Invalid line format");
+        }
+        input.plain.push_back(DigInstruction{parseDirection(line.front()), std::stoll(line.substr(2U))});
+        input.encoded.push_back(parseEncodedInstruction(line));
+    };
     parseInput(filePath, lineCallback);
     return input;
 }
 
-uint64_t calculatePartOne(const std::vector<std::string>& input) {
-    return 0U;
+uint64_t calculateLagoonSize(const std::vector<DigInstruction>& instructions) {
+    LatticePolygon trench;
+    for (const auto& instruction : instructions) {
+        switch (instruction.direction) {
+            case Direction::RIGHT:
+                trench.moveBy(instruction.distance, 0);
+                break;
+            case Direction::DOWN:
+                trench.moveBy(0, instruction.distance);
+                break;
+            case Direction::LEFT:
+                trench.moveBy(-instruction.distance, 0);
+                break;
+            case Direction::UP:
+                trench.moveBy(0, -instruction.distance);
+                break;
+        }
+    }
+    return static_cast<uint64_t>(trench.coveredPoints());
+}
+
+uint64_t calculatePartOne(const DigPlan& input) {
+    return calculateLagoonSize(input.plain);
 }
 
-uint64_t calculatePartTwo(const std::vector<std::string>& input) {
-    return 0U;
+uint64_t calculatePartTwo(const DigPlan& input) {
+    return calculateLagoonSize(input.encoded);
 }
 }  // namespace
 
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include "bblp/aoc/scoped_puzzle_input.hpp"
 #include "days.hpp"
 
 namespace bblp::aoc::test {
@@ -8,4 +9,23 @@ TEST(Day3, test) {
     EXPECT_EQ("529618", result.first);
     EXPECT_EQ("77509019", result.second);
 }
+
+TEST(Day3, numbersAtRowEdges) {
+    const ScopedPuzzleInput input{"day03",
+                                  "467..114..\n"
+                                  "...*......\n"
+                                  "..35..633.\n"
+                                  "......#...\n"
+                                  "617*......\n"
+                                  ".....+.58.\n"
+                                  "..592.....\n"
+                                  "......755.\n"
+                                  "...$.*....\n"
+                                  ".664.598..\n"
+                                  "12.......9\n"
+                                  "*.......*.\n"};
+    const auto result = day03();
+    EXPECT_EQ("4382", result.first);
+    EXPECT_EQ("467835", result.second);
+}
 };  // namespace bblp::aoc::test
@@ -1,77 +1,136 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
+#include "bblp/aoc/solution.hpp"
 #include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstdlib>
 #include <numeric>
-#include <regex>
+#include <unordered_map>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
+struct LocationLists {
+    std::vector<int32_t> left;
+    std::vector<int32_t> right;
+};
 
 auto parse(const std::filesystem::path& filePath) {
     static constexpr std::size_t BUFFER_SIZE = 10000;
 
-    std::vector<std::string> input;
-    input.reserve(BUFFER_SIZE);
-    const auto lineCallback = [&input](const std::string& line) { input.push_back(line); };
+    LocationLists input;
+    input.left.reserve(BUFFER_SIZE);
+    input.right.reserve(BUFFER_SIZE);
+    const auto lineCallback = [&input](const std::string& line) {
+        const auto parts = split(line, " ");
+        input.left.emplace_back(std::stoul(parts.front()));
+        input.right.emplace_back(std::stoul(parts.back()));
+    };
     parseInput(filePath, lineCallback);
     return input;
 }
 
-int calculatePartOne(const std::vector<std::string>& input) {
-    std::vector<int32_t> leftList, rightList;
-    leftList.reserve(input.size());
-    rightList.reserve(input.size());
-
-    for (auto const& line : input) {
-        const auto parts = split(line, " ");
-        leftList.emplace_back(std::stoul(parts.front()));
-        rightList.emplace_back(std::stoul(parts.back()));
+// LSD radix sort over 8-bit digits. The sign bit is flipped so negative values order correctly as unsigned keys.
+void radixSort(std::vector<int32_t>& values) {
+    static constexpr uint32_t DIGIT_BITS = 8U;
+    static constexpr uint32_t BUCKET_COUNT = 1U << DIGIT_BITS;
+    static constexpr uint32_t SIGN_BIT = 0x80000000U;
+
+    std::vector<uint32_t> keys(values.size());
+    std::transform(values.cbegin(), values.cend(), keys.begin(),
+                   [](const int32_t value) { return static_cast<uint32_t>(value) ^ SIGN_BIT; });
+    std::vector<uint32_t> buffer(keys.size());
+
+    for (uint32_t shift = 0U; shift < 32U; shift += DIGIT_BITS) {
+        std::array<std::size_t, BUCKET_COUNT> offsets{};
+        for (const auto key : keys) {
+            ++offsets[(key >> shift) & (BUCKET_COUNT - 1U)];
+        }
+        if (offsets[(keys.empty() ? 0U : keys.front() >> shift) & (BUCKET_COUNT - 1U)] == keys.size()) {
+            continue;
+        }
+
+        std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), std::size_t{0U});
+        for (const auto key : keys) {
+            buffer[offsets[(key >> shift) & (BUCKET_COUNT - 1U)]++] = key;
+        }
+        keys.swap(buffer);
     }
-    
-    std::sort(leftList.begin(), leftList.end());
-    std::sort(rightList.begin(), rightList.end());
 
-    uint32_t distance = 0U;
+    std::transform(keys.cbegin(), keys.cend(), values.begin(),
+                   [](const uint32_t key) { return static_cast<int32_t>(key ^ SIGN_BIT); });
+}
 
-    for (auto i = 0U; i < leftList.size(); ++i) {
-        distance += std::abs(leftList.at(i) - rightList.at(i));
-    }
+uint64_t calculatePartOne(const LocationLists& input) {
+    auto leftList = input.left;
+    auto rightList = input.right;
+    radixSort(leftList);
+    radixSort(rightList);
 
+    uint64_t distance{0U};
+    for (std::size_t i = 0U; i < leftList.size(); ++i) {
+        distance += static_cast<uint64_t>(std::abs(static_cast<int64_t>(leftList[i]) - rightList[i]));
+    }
     return distance;
 }
 
-int calculatePartTwo(const std::vector<std::string>& input) {
-    std::vector<int32_t> leftList, rightList;
-    leftList.reserve(input.size());
-    rightList.reserve(input.size());
-
-    for (auto const& line : input) {
-        const auto parts = split(line, " ");
-        leftList.emplace_back(std::stoul(parts.front()));
-        rightList.emplace_back(std::stoul(parts.back()));
+// Counts how often each value occurs in the right list: a dense array when the values span a range no wider than
+// a few slots per value, a hash map otherwise.
+class FrequencyTable {
+  public:
+    explicit FrequencyTable(const std::vector<int32_t>& values) {
+        static constexpr int64_t MAX_DENSE_SLOTS_PER_VALUE = 8;
+
+        if (values.empty()) {
+            return;
+        }
+
+        const auto [minIter, maxIter] = std::minmax_element(values.cbegin(), values.cend());
+        const auto range = static_cast<int64_t>(*maxIter) - *minIter + 1;
+        if (range <= MAX_DENSE_SLOTS_PER_VALUE * static_cast<int64_t>(values.size())) {
+            mMin = *minIter;
+            mDenseCounts.resize(static_cast<std::size_t>(range), 0U);
+            for (const auto value : values) {
+                ++mDenseCounts[static_cast<std::size_t>(static_cast<int64_t>(value) - mMin)];
+            }
+        } else {
+            mSparseCounts.reserve(values.size());
+            for (const auto value : values) {
+                ++mSparseCounts[value];
+            }
+        }
     }
 
-    std::unordered_map<int32_t, uint32_t> scores;
-    for (auto left : leftList) {
-        auto const count = std::count(rightList.cbegin(), rightList.cend(), left);;
-        scores[left] += left * count;
-    }
+    [[nodiscard]] uint32_t count(const int32_t value) const {
+        if (!mDenseCounts.empty()) {
+            const auto index = static_cast<int64_t>(value) - mMin;
+            return (index >= 0 && index < static_cast<int64_t>(mDenseCounts.size())) ? mDenseCounts[index] : 0U;
+        }
 
-    return std::accumulate(scores.cbegin(), scores.cend(), 0U, [](const uint32_t sum, const auto &item) { 
-        return sum + item.second;
-    });
+        const auto iter = mSparseCounts.find(value);
+        return iter != mSparseCounts.cend() ? iter->second : 0U;
+    }
 
+  private:
+    int64_t mMin{0};
+    std::vector<uint32_t> mDenseCounts;
+    std::unordered_map<int32_t, uint32_t> mSparseCounts;
+};
+
+int64_t calculatePartTwo(const LocationLists& input) {
+    const FrequencyTable rightCounts{input.right};
+    return std::accumulate(input.left.cbegin(), input.left.cend(), static_cast<int64_t>(0),
+                           [&rightCounts](const int64_t sum, const int32_t left) {
+                               return sum + static_cast<int64_t>(left) * rightCounts.count(left);
+                           });
 }
 }  // namespace
 
 std::pair<std::string, std::string> day01() {
-    const auto input = parse("resources/day01.txt");
-
-    return {std::to_string(calculatePartOne(input)), std::to_string(calculatePartTwo(input))};
+    return solve([]() { return parse("resources/day01.txt"); }, calculatePartOne, calculatePartTwo);
 }
 }  // namespace bblp::aoc
@@ -1,94 +1,112 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/string_utils.hpp"
+#include "bblp/aoc/parallel.hpp"
 
-#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
-#include <numeric>
-#include <regex>
+#include <span>
+#include <stdexcept>
+#include <string_view>
 #include <vector>
 
 namespace bblp::aoc {
 namespace {
+static constexpr std::size_t NO_SKIP = static_cast<std::size_t>(-1);
 
-struct Report {
+// All levels are stored back to back; report i spans levels[offsets[i], offsets[i + 1]).
+struct Reports {
+    std::vector<std::size_t> offsets{0U};
     std::vector<int32_t> levels;
+
+    [[nodiscard]] std::size_t size() const { return offsets.size() - 1U; }
+    [[nodiscard]] std::span<const int32_t> at(const std::size_t index) const {
+        return std::span<const int32_t>{levels}.subspan(offsets[index], offsets[index + 1U] - offsets[index]);
+    }
 };
 
 auto parse(const std::filesystem::path& filePath) {
     static constexpr std::size_t BUFFER_SIZE = 10000;
 
-    std::vector<Report> input;
-    input.reserve(BUFFER_SIZE);
+    Reports input;
+    input.offsets.reserve(BUFFER_SIZE);
+    input.levels.reserve(BUFFER_SIZE);
     const auto lineCallback = [&input](const std::string& line) {
-        const auto parts = split(line, " ");
-        Report report;
-        for (const auto& part : parts) {
-            report.levels.push_back(std::stoul(part));
+        if (line.empty()) {
+            return;
         }
-        input.push_back(report);
+
+        const std::string_view view{line};
+        std::size_t pos = view.find_first_not_of(' ');
+        while (pos != std::string_view::npos) {
+            const auto end = std::min(view.find(' ', pos), view.size());
+            input.levels.push_back(std::stoi(std::string{view.substr(pos, end - pos)}));
+            pos = view.find_first_not_of(' ', end);
+        }
+        input.offsets.push_back(input.levels.size());
     };
     parseInput(filePath, lineCallback);
     return input;
 }
 
-bool isReportSafe(const Report& report) {
-    std::optional<bool> isIncreasing;
-    for (size_t index = 0U; index < report.levels.size() - 1; ++index) {
-        const auto diff = report.levels.at(index + 1) - report.levels.at(index);
-        if (diff == 0) {
-            return false;
-        }
+bool isStepSafe(const int32_t from, const int32_t to, const int32_t direction) {
+    const auto diff = (to - from) * direction;
+    return diff >= 1 && diff <= 3;
+}
 
-        if (isIncreasing.has_value()) {
-            if (isIncreasing.value()) {
-                if (diff < 0) {
-                    return false;
-                }
-            } else {
-                if (diff > 0) {
-                    return false;
-                }
-            }
-        } else {
-            isIncreasing = diff > 0;
+// Index of the first level whose step to the next (ignoring `skip`) is unsafe, or NO_SKIP if every step is safe.
+std::size_t findFirstUnsafeStep(const std::span<const int32_t> levels,
+                                const int32_t direction,
+                                const std::size_t skip) {
+    std::size_t previous = NO_SKIP;
+    for (std::size_t i = 0U; i < levels.size(); ++i) {
+        if (i == skip) {
+            continue;
         }
-
-        if (std::abs(diff) > 3) {
-            return false;
+        if (previous != NO_SKIP && !isStepSafe(levels[previous], levels[i], direction)) {
+            return previous;
         }
+        previous = i;
     }
-
-    return true;
+    return NO_SKIP;
 }
 
-bool canReportBeSafe(const Report& input) {
-    const auto isSafe = isReportSafe(input);
-    if (isSafe) {
-        return true;
-    }
-
-    for (auto i = 0U; i < input.levels.size(); ++i) {
-        Report newReport{input};
-
-        auto it = newReport.levels.begin();
-        std::advance(it, i);
-        newReport.levels.erase(it);
+bool isReportSafe(const std::span<const int32_t> levels) {
+    return findFirstUnsafeStep(levels, 1, NO_SKIP) == NO_SKIP || findFirstUnsafeStep(levels, -1, NO_SKIP) == NO_SKIP;
+}
 
-        if (isReportSafe(newReport)) {
+// Once the first unsafe step between levels i and i + 1 is known, only removing one of those two can help, since
+// every other removal leaves that step in place. So each direction needs at most three linear scans.
+bool canReportBeSafe(const std::span<const int32_t> levels) {
+    for (const int32_t direction : {1, -1}) {
+        const auto unsafe = findFirstUnsafeStep(levels, direction, NO_SKIP);
+        if (unsafe == NO_SKIP || findFirstUnsafeStep(levels, direction, unsafe) == NO_SKIP ||
+            findFirstUnsafeStep(levels, direction, unsafe + 1U) == NO_SKIP) {
             return true;
         }
     }
     return false;
 }
 
-int calculatePartOne(const std::vector<Report>& input) {
-    return std::count_if(input.cbegin(), input.cend(), isReportSafe);
+template <typename Predicate>
+uint64_t countReports(const Reports& input, const Predicate& predicate) {
+    return parallelSum<uint64_t>(input.size(), [&input, &predicate](std::size_t begin, std::size_t end) {
+        uint64_t count{0U};
+        for (auto i = begin; i < end; ++i) {
+            if (predicate(input.at(i))) {
+                ++count;
+            }
+        }
+        return count;
+    });
+}
+
+uint64_t calculatePartOne(const Reports& input) {
+    return countReports(input, isReportSafe);
 }
 
-int calculatePartTwo(const std::vector<Report>& input) {
-    return std::count_if(input.cbegin(), input.cend(), canReportBeSafe);
+uint64_t calculatePartTwo(const Reports& input) {
+    return countReports(input, canReportBeSafe);
 }
 }  // namespace
 
@@ -1,18 +1,17 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/string_utils.hpp"
+#include "bblp/aoc/parallel.hpp"
 
-#include <iostream>
-#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
-#include <numeric>
-#include <regex>
-#include <vector>
+#include <optional>
+#include <string_view>
 
 namespace bblp::aoc {
 namespace {
-
+static constexpr std::size_t CHUNK_SIZE = 1U << 16U;
+static constexpr uint32_t MAX_OPERAND_DIGITS = 3U;
 
 auto parse(const std::filesystem::path& filePath) {
     static constexpr std::size_t BUFFER_SIZE = 10000;
@@ -24,56 +23,180 @@ auto parse(const std::filesystem::path& filePath) {
     return input;
 }
 
-int calculatePartOne(const std::string& input) {
-    const std::string pattern{R"(mul\([0-9]{1,3},[0-9]{1,3}\))"};
-    std::regex regex{pattern};
-    std::smatch match;
-
-    auto searchStart{input.cbegin()};
-    uint64_t result = 0U;
-    while (std::regex_search(searchStart, input.cend(), match, regex)) {
-        for (const auto& mul: match) {
-            const auto parts = split(mul.str(), ",");
-            std::string first{parts.front().cbegin() + 4, parts.front().cend()};
-            std::string second{parts.back().cbegin(), parts.back().cend() - 1};
-            result += std::stoul(first.data()) * std::stoul(second.data());
+// What a slice of memory contributes, independent of whether multiplications are enabled when the slice starts.
+// Summaries of consecutive slices combine in order with +=, so slices can be scanned in parallel.
+struct MemorySummary {
+    uint64_t allProducts{0U};
+    // Products before the first do()/don't() of the slice; they count only if the slice starts enabled.
+    uint64_t productsBeforeToggle{0U};
+    // Enabled products after the first do()/don't() of the slice.
+    uint64_t productsAfterToggle{0U};
+    // Whether multiplications are enabled at the end of the slice, if it contains any do()/don't().
+    std::optional<bool> enabledAtEnd;
+
+    void addProduct(const uint64_t product) {
+        allProducts += product;
+        if (!enabledAtEnd.has_value()) {
+            productsBeforeToggle += product;
+        } else if (*enabledAtEnd) {
+            productsAfterToggle += product;
+        }
+    }
+
+    MemorySummary& operator+=(const MemorySummary& next) {
+        allProducts += next.allProducts;
+        if (enabledAtEnd.has_value()) {
+            productsAfterToggle += (*enabledAtEnd ? next.productsBeforeToggle : 0U) + next.productsAfterToggle;
+            enabledAtEnd = next.enabledAtEnd.has_value() ? next.enabledAtEnd : enabledAtEnd;
+        } else {
+            productsBeforeToggle += next.productsBeforeToggle;
+            productsAfterToggle = next.productsAfterToggle;
+            enabledAtEnd = next.enabledAtEnd;
         }
-        searchStart = match.suffix().first;
+        return *this;
     }
+};
+
+enum class ScanState : uint8_t {
+    START,
+    M,
+    MU,
+    MUL,
+    FIRST_OPERAND,
+    SECOND_OPERAND,
+    D,
+    DO,
+    DO_OPEN,
+    DON,
+    DON_APOSTROPHE,
+    DON_T,
+    DON_T_OPEN
+};
 
-    return result;
+bool isDigit(const char c) {
+    return c >= '0' && c <= '9';
 }
 
-int calculatePartTwo(const std::string& input) {
-    const std::string pattern{R"((do\(\))|(don't\(\))|(mul\([0-9]{1,3},[0-9]{1,3}\)))"};
-    std::regex regex{pattern};
-    std::smatch match;
-    auto searchStart{input.cbegin()};
-    uint64_t result = 0U;
-    bool enabled = true;
-    while (std::regex_search(searchStart, input.cend(), match, regex)) {
-        if (match.empty()) {
-            continue;
-        }
+// Recognises mul(a,b), do() and don't() byte by byte for every instruction starting in [begin, end). An instruction
+// starting before `end` is finished even if it reaches past it, so adjacent slices together see every instruction
+// exactly once. Outside of an instruction the scanner skips straight to the next 'm' or 'd'.
+MemorySummary scanMemory(const std::string_view memory, std::size_t pos, const std::size_t end) {
+    MemorySummary summary;
+    ScanState state{ScanState::START};
+    uint32_t digits{0U};
+    uint64_t first{0U};
+    uint64_t second{0U};
+
+    const auto expect = [&state](const char c, const char expected, const ScanState next) {
+        state = (c == expected) ? next : ScanState::START;
+        return c == expected;
+    };
 
-        if (match[1].matched) {
-            enabled = true;
-        } else if (match[2].matched) {
-            enabled = false;
-        } else if (match[3].matched) {
-            if (enabled) {
-                const auto parts = split(match[3].str(), ",");
-                std::string first{parts.front().cbegin() + 4, parts.front().cend()};
-                std::string second{parts.back().cbegin(), parts.back().cend() - 1};
-                result += std::stoul(first.data()) * std::stoul(second.data());
+    while (pos < memory.size() && (pos < end || state != ScanState::START)) {
+        if (state == ScanState::START) {
+            pos = memory.find_first_of("md", pos);
+            if (pos == std::string_view::npos || pos >= end) {
+                break;
             }
-        
         }
 
-        searchStart = match.suffix().first;
+        const auto c = memory[pos];
+        bool consumed{true};
+        switch (state) {
+            case ScanState::START:
+                state = (c == 'm') ? ScanState::M : ScanState::D;
+                break;
+            case ScanState::M:
+                consumed = expect(c, 'u', ScanState::MU);
+                break;
+            case ScanState::MU:
+                consumed = expect(c, 'l', ScanState::MUL);
+                break;
+            case ScanState::MUL:
+                consumed = expect(c, '(', ScanState::FIRST_OPERAND);
+                digits = 0U;
+                first = 0U;
+                break;
+            case ScanState::FIRST_OPERAND:
+                if (isDigit(c) && digits < MAX_OPERAND_DIGITS) {
+                    first = first * 10U + static_cast<uint64_t>(c - '0');
+                    ++digits;
+                } else if (c == ',' && digits > 0U) {
+                    state = ScanState::SECOND_OPERAND;
+                    digits = 0U;
+                    second = 0U;
+                } else {
+                    state = ScanState::START;
+                    consumed = false;
+                }
+                break;
+            case ScanState::SECOND_OPERAND:
+                if (isDigit(c) && digits < MAX_OPERAND_DIGITS) {
+                    second = second * 10U + static_cast<uint64_t>(c - '0');
+                    ++digits;
+                } else if (c == ')' && digits > 0U) {
+                    summary.addProduct(first * second);
+                    state = ScanState::START;
+                } else {
+                    state = ScanState::START;
+                    consumed = false;
+                }
+                break;
+            case ScanState::D:
+                consumed = expect(c, 'o', ScanState::DO);
+                break;
+            case ScanState::DO:
+                if (c == '(') {
+                    state = ScanState::DO_OPEN;
+                } else {
+                    consumed = expect(c, 'n', ScanState::DON);
+                }
+                break;
+            case ScanState::DO_OPEN:
+                if (c == ')') {
+                    summary.enabledAtEnd = true;
+                }
+                consumed = expect(c, ')', ScanState::START);
+                break;
+            case ScanState::DON:
+                consumed = expect(c, '\'', ScanState::DON_APOSTROPHE);
+                break;
+            case ScanState::DON_APOSTROPHE:
+                consumed = expect(c, 't', ScanState::DON_T);
+                break;
+            case ScanState::DON_T:
+                consumed = expect(c, '(', ScanState::DON_T_OPEN);
+                break;
+            case ScanState::DON_T_OPEN:
+                if (c == ')') {
+                    summary.enabledAtEnd = false;
+                }
+                consumed = expect(c, ')', ScanState::START);
+                break;
+        }
+
+        // A byte that breaks an instruction may itself start the next one, so it is looked at again from START.
+        if (consumed) {
+            ++pos;
+        }
     }
+    return summary;
+}
+
+MemorySummary summarizeMemory(const std::string& input) {
+    const auto chunkCount = (input.size() + CHUNK_SIZE - 1U) / CHUNK_SIZE;
+    return parallelSum<MemorySummary>(chunkCount, [&input](std::size_t begin, std::size_t end) {
+        return scanMemory(input, begin * CHUNK_SIZE, std::min(end * CHUNK_SIZE, input.size()));
+    });
+}
+
+uint64_t calculatePartOne(const std::string& input) {
+    return summarizeMemory(input).allProducts;
+}
 
-    return result;
+uint64_t calculatePartTwo(const std::string& input) {
+    const auto summary = summarizeMemory(input);
+    return summary.productsBeforeToggle + summary.productsAfterToggle;
 }
 }  // namespace
 
@@ -1,18 +1,19 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/string_utils.hpp"
-#include "bblp/aoc/point.hpp"
+#include "bblp/aoc/parallel.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstdlib>
 #include <numeric>
-#include <regex>
+#include <string_view>
 #include <vector>
-#include <iostream>
 
 namespace bblp::aoc {
 namespace {
+static constexpr char PADDING = '\0';
 
 auto parse(const std::filesystem::path& filePath) {
     static constexpr std::size_t BUFFER_SIZE = 10000;
@@ -24,85 +25,122 @@ auto parse(const std::filesystem::path& filePath) {
     return input;
 }
 
-bool checkInDirection(const std::vector<std::string>& input, const Point center, int xDiff, int yDiff) {
-    if (center.x + 3 * xDiff < 0 || center.x + 3 * xDiff >= input.at(center.y).size()) {
-        return false;
+// The letters stored row by row in one buffer and surrounded by `padding` cells on every side, so any position up
+// to `padding` steps away from a letter can be read without bounds checks.
+class PaddedGrid {
+  public:
+    PaddedGrid(const std::vector<std::string>& rows, const std::size_t padding)
+        : mWidth(rows.empty() ? 0U : rows.front().size()),
+          mHeight(rows.size()),
+          mPadding(padding),
+          mStride(mWidth + 2U * padding),
+          mCells(mStride * (mHeight + 2U * padding), PADDING) {
+        for (std::size_t y = 0U; y < mHeight; ++y) {
+            std::copy_n(rows[y].cbegin(), std::min(rows[y].size(), mWidth), mCells.begin() + index(0, y));
+        }
     }
 
-    if (center.y + 3 * yDiff < 0 || center.y + 3 * yDiff >= input.size()) {
-        return false;
+    [[nodiscard]] std::size_t width() const { return mWidth; }
+    [[nodiscard]] std::size_t height() const { return mHeight; }
+    [[nodiscard]] std::size_t padding() const { return mPadding; }
+    [[nodiscard]] std::ptrdiff_t offset(const int dx, const int dy) const {
+        return static_cast<std::ptrdiff_t>(dy) * static_cast<std::ptrdiff_t>(mStride) + dx;
     }
+    // Pointer to the first letter of row y; valid to move up to `padding` cells in any direction from a letter.
+    [[nodiscard]] const char* row(const std::size_t y) const { return mCells.data() + index(0, y); }
 
-    return (input.at(center.y + yDiff).at(center.x + xDiff) == 'M' &&
-            input.at(center.y + 2 * yDiff).at(center.x + 2 * xDiff) == 'A' &&
-            input.at(center.y + 3 * yDiff).at(center.x + 3 * xDiff) == 'S');
-}
-
-int calculatePartOne(const std::vector<std::string>& input) {
-    uint32_t count = 0U;
-    for (int y = 0; y < input.size(); ++y) {
-        for (int x = 0; x < input.at(y).size(); ++x) {
-            if (input.at(y).at(x) != 'X') {
-                continue;
-            }
-
-
-            if (checkInDirection(input, {x, y}, -1, -1)) {
-                count++;
-            }
-
-            if (checkInDirection(input, {x, y}, 0, -1)) {
-                count++;
-            }
-
-            if (checkInDirection(input, {x, y}, 1, -1)) {
-                count++;
-            }
-
-            if (checkInDirection(input, {x, y}, 1, 0)) {
-                count++;
-            }
-
-            if (checkInDirection(input, {x, y}, 1, 1)) {
-                count++;
-            }
-
-            if (checkInDirection(input, {x, y}, 0, 1)) {
-                count++;
-            }
-
-            if (checkInDirection(input, {x, y}, -1, 1)) {
-                count++;
-            }
+  private:
+    [[nodiscard]] std::size_t index(const std::size_t x, const std::size_t y) const {
+        return (y + mPadding) * mStride + x + mPadding;
+    }
 
-            if (checkInDirection(input, {x, y}, -1, 0)) {
-                count++;
+    std::size_t mWidth;
+    std::size_t mHeight;
+    std::size_t mPadding;
+    std::size_t mStride;
+    std::vector<char> mCells;
+};
+
+struct Direction {
+    int dx;
+    int dy;
+};
+
+constexpr std::array<Direction, 8U> ALL_DIRECTIONS{
+    {{-1, -1}, {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}}};
+
+// Every row keeps a match mask over all start positions; letter k of the word is checked for the whole row at once
+// against the row shifted by k steps in the given direction. Each of those loops is a plain byte compare over
+// contiguous memory that the compiler vectorises.
+uint64_t countWordInRows(const PaddedGrid& grid,
+                         const std::string_view word,
+                         const std::size_t firstRow,
+                         const std::size_t lastRow) {
+    std::vector<uint8_t> matches(grid.width());
+    uint64_t count{0U};
+    for (std::size_t y = firstRow; y < lastRow; ++y) {
+        const auto* row = grid.row(y);
+        for (const auto& direction : ALL_DIRECTIONS) {
+            const auto step = grid.offset(direction.dx, direction.dy);
+            std::fill(matches.begin(), matches.end(), static_cast<uint8_t>(1U));
+            for (std::size_t k = 0U; k < word.size(); ++k) {
+                const auto* shifted = row + static_cast<std::ptrdiff_t>(k) * step;
+                const auto letter = word[k];
+                for (std::size_t x = 0U; x < matches.size(); ++x) {
+                    matches[x] &= static_cast<uint8_t>(shifted[x] == letter);
+                }
             }
+            count += std::accumulate(matches.cbegin(), matches.cend(), static_cast<uint64_t>(0U));
         }
     }
     return count;
 }
 
-int calculatePartTwo(const std::vector<std::string>& input) {
-    uint32_t count = 0U;
-    for (int y = 1; y < input.size() - 1; ++y) {
-        for (int x = 1; x < input.at(y).size() - 1; ++x) {
-            if (input.at(y).at(x) != 'A') {
-                continue;
-            }
+// Counts occurrences of `word` written in any of the eight directions.
+uint64_t countWord(const std::vector<std::string>& input, const std::string_view word) {
+    if (word.empty()) {
+        return 0U;
+    }
 
-            bool const crossForward = (input.at(y - 1).at(x - 1) == 'M' && input.at(y + 1).at(x + 1) == 'S') ||
-                                      (input.at(y - 1).at(x - 1) == 'S' && input.at(y + 1).at(x + 1) == 'M');
-            bool const crossBackward = (input.at(y - 1).at(x + 1) == 'M' && input.at(y + 1).at(x - 1) == 'S') ||
-                                      (input.at(y - 1).at(x + 1) == 'S' && input.at(y + 1).at(x - 1) == 'M');
+    const PaddedGrid grid{input, word.size() - 1U};
+    return parallelSum<uint64_t>(grid.height(), [&grid, word](std::size_t begin, std::size_t end) {
+        return countWordInRows(grid, word, begin, end);
+    });
+}
 
-            if (crossForward && crossBackward) {
-                count++;
-            }
+uint64_t countCrossesInRows(const PaddedGrid& grid, const std::size_t firstRow, const std::size_t lastRow) {
+    const auto upLeft = grid.offset(-1, -1);
+    const auto upRight = grid.offset(1, -1);
+    const auto downLeft = grid.offset(-1, 1);
+    const auto downRight = grid.offset(1, 1);
+
+    uint64_t count{0U};
+    for (std::size_t y = firstRow; y < lastRow; ++y) {
+        const auto* row = grid.row(y);
+        uint32_t rowCount{0U};
+        for (std::size_t x = 0U; x < grid.width(); ++x) {
+            const auto* center = row + x;
+            const auto forward = (center[upLeft] == 'M' && center[downRight] == 'S') ||
+                                 (center[upLeft] == 'S' && center[downRight] == 'M');
+            const auto backward = (center[upRight] == 'M' && center[downLeft] == 'S') ||
+                                  (center[upRight] == 'S' && center[downLeft] == 'M');
+            rowCount += static_cast<uint32_t>(*center == 'A' && forward && backward);
         }
+        count += rowCount;
     }
     return count;
 }
+
+uint64_t calculatePartOne(const std::vector<std::string>& input) {
+    return countWord(input, "XMAS");
+}
+
+uint64_t calculatePartTwo(const std::vector<std::string>& input) {
+    const PaddedGrid grid{input, 1U};
+    return parallelSum<uint64_t>(grid.height(), [&grid](std::size_t begin, std::size_t end) {
+        return countCrossesInRows(grid, begin, end);
+    });
+}
 }  // namespace
 
 std::pair<std::string, std::string> day04() {
@@ -1,14 +1,15 @@
 #include "days.hpp"
 
 #include "bblp/aoc/file_utils.hpp"
-#include "bblp/aoc/point.hpp"
+#include "bblp/aoc/parallel.hpp"
 #include "bblp/aoc/string_utils.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
-#include <iostream>
-#include <numeric>
-#include <regex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_set>
 #include <vector>
 
 namespace bblp::aoc {
@@ -52,70 +53,137 @@ auto parse(const std::filesystem::path& filePath) {
     return input;
 }
 
-bool areUpdatePagesInCorrectOrder(const Update& update, const std::vector<Rule>& rules) {
-    for (auto iter = update.pages.cbegin(); iter != update.pages.cend(); ++iter) {
-        for (auto iter2 = std::next(iter); iter2 != update.pages.cend(); ++iter2) {
-            for (const auto& rule : rules) {
-                if (rule.preceding != *iter2) {
-                    continue;
-                }
+// Answers "must page a come before page b" in O(1): a dense bit matrix indexed by page ids when they are small
+// enough, otherwise a hash set of packed (preceding, following) pairs.
+class PrecedenceRules {
+  public:
+    explicit PrecedenceRules(const std::vector<Rule>& rules) {
+        static constexpr int32_t MAX_DENSE_PAGE_COUNT = 4096;
 
-                if (rule.following == *iter) {
-                    return false;
-                }
+        int32_t maxPage{-1};
+        bool allPagesNonNegative{true};
+        for (const auto& rule : rules) {
+            maxPage = std::max({maxPage, rule.preceding, rule.following});
+            allPagesNonNegative = allPagesNonNegative && rule.preceding >= 0 && rule.following >= 0;
+        }
+
+        if (allPagesNonNegative && maxPage < MAX_DENSE_PAGE_COUNT) {
+            mPageCount = static_cast<std::size_t>(maxPage + 1);
+            mMatrix.resize(mPageCount * mPageCount, false);
+            for (const auto& rule : rules) {
+                mMatrix[rule.preceding * mPageCount + rule.following] = true;
+            }
+        } else {
+            mPairs.reserve(rules.size());
+            for (const auto& rule : rules) {
+                mPairs.insert(packPair(rule.preceding, rule.following));
             }
         }
     }
 
-    return true;
-}
+    [[nodiscard]] bool mustPrecede(const int32_t preceding, const int32_t following) const {
+        if (mPairs.empty()) {
+            return preceding >= 0 && following >= 0 && static_cast<std::size_t>(preceding) < mPageCount &&
+                   static_cast<std::size_t>(following) < mPageCount && mMatrix[preceding * mPageCount + following];
+        }
+        return mPairs.contains(packPair(preceding, following));
+    }
 
-Update reorderUpdate(const Update& update, const std::vector<Rule>& rules) {
-    Update newUpdate{update.pages};
+  private:
+    static uint64_t packPair(const int32_t preceding, const int32_t following) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(preceding)) << 32U) | static_cast<uint32_t>(following);
+    }
 
-    std::sort(newUpdate.pages.begin(), newUpdate.pages.end(), [&rules](int32_t left, int32_t right) {
-        for (const auto& rule : rules) {
-            if (rule.preceding == left && rule.following == right) {
-                return true;
-            }
+    std::size_t mPageCount{0U};
+    std::vector<bool> mMatrix;
+    std::unordered_set<uint64_t> mPairs;
+};
 
-            if (rule.preceding == right && rule.following == left) {
+bool areUpdatePagesInCorrectOrder(const Update& update, const PrecedenceRules& rules) {
+    for (auto iter = update.pages.cbegin(); iter != update.pages.cend(); ++iter) {
+        for (auto iter2 = std::next(iter); iter2 != update.pages.cend(); ++iter2) {
+            if (rules.mustPrecede(*iter2, *iter)) {
                 return false;
             }
         }
-        return false;
-    });
+    }
 
-    return newUpdate;
+    return true;
 }
 
-int calculatePartOne(const Manual& input) {
-    int result = 0;
-    for (const auto& update : input.updates) {
-        if (areUpdatePagesInCorrectOrder(update, input.rules)) {
-            result += update.pages.at(update.pages.size() / 2);
+// Orders the update by repeatedly taking a page that no remaining page has to precede (Kahn's algorithm restricted
+// to the pages of this update).
+std::vector<int32_t> sortUpdateTopologically(const Update& update, const PrecedenceRules& rules) {
+    std::vector<int32_t> remaining{update.pages};
+    std::vector<int32_t> sorted;
+    sorted.reserve(remaining.size());
+    while (!remaining.empty()) {
+        const auto next = std::find_if(remaining.begin(), remaining.end(), [&remaining, &rules](int32_t page) {
+            return std::none_of(remaining.cbegin(), remaining.cend(),
+                                [&rules, page](int32_t other) { return rules.mustPrecede(other, page); });
+        });
+        if (next == remaining.end()) {
+            throw std::logic_error("Rules for update contain a cycle");
         }
+        sorted.push_back(*next);
+        remaining.erase(next);
     }
-
-    return result;
+    return sorted;
 }
 
-int calculatePartTwo(const Manual& input) {
-    int result = 0;
-    for (const auto& update : input.updates) {
-        if (!areUpdatePagesInCorrectOrder(update, input.rules)) {
-            const Update reorderedUpdate = reorderUpdate(update, input.rules);
-            result += reorderedUpdate.pages.at(reorderedUpdate.pages.size() / 2);
+// When the rules order every pair of pages, the predecessor counts within the update are exactly 0..n-1 and the
+// middle page of the corrected update is the one preceded by half of the others, so it can be picked by counting.
+// Any other set of counts means some pairs are unordered, and the update is sorted instead.
+int32_t findMiddlePageOfReorderedUpdate(const Update& update, const PrecedenceRules& rules) {
+    const auto pageCount = update.pages.size();
+    const auto middleIndex = pageCount / 2U;
+
+    std::vector<bool> isCountTaken(pageCount, false);
+    std::optional<int32_t> middlePage;
+    for (const auto page : update.pages) {
+        const auto isPredecessor = [&rules, page](int32_t other) { return rules.mustPrecede(other, page); };
+        const auto predecessors =
+            static_cast<std::size_t>(std::count_if(update.pages.cbegin(), update.pages.cend(), isPredecessor));
+        if (predecessors >= pageCount || isCountTaken[predecessors]) {
+            return sortUpdateTopologically(update, rules).at(middleIndex);
+        }
+
+        isCountTaken[predecessors] = true;
+        if (predecessors == middleIndex) {
+            middlePage = page;
         }
     }
+    return *middlePage;
+}
 
-    return result;
+template <typename UpdateValue>
+int64_t sumOverUpdates(const Manual& input, const UpdateValue& updateValue) {
+    return parallelSum<int64_t>(input.updates.size(), [&input, &updateValue](std::size_t begin, std::size_t end) {
+        int64_t sum{0};
+        for (auto i = begin; i < end; ++i) {
+            sum += updateValue(input.updates[i]);
+        }
+        return sum;
+    });
+}
+
+int64_t calculatePartOne(const Manual& input, const PrecedenceRules& rules) {
+    return sumOverUpdates(input, [&rules](const Update& update) -> int64_t {
+        return areUpdatePagesInCorrectOrder(update, rules) ? update.pages.at(update.pages.size() / 2) : 0;
+    });
+}
+
+int64_t calculatePartTwo(const Manual& input, const PrecedenceRules& rules) {
+    return sumOverUpdates(input, [&rules](const Update& update) -> int64_t {
+        return areUpdatePagesInCorrectOrder(update, rules) ? 0 : findMiddlePageOfReorderedUpdate(update, rules);
+    });
 }
 }  // namespace
 
 std::pair<std::string, std::string> day05() {
     const auto input = parse("resources/day05.txt");
+    const PrecedenceRules rules{input.rules};
 
-    return {std::to_string(calculatePartOne(input)), std::to_string(calculatePartTwo(input))};
+    return {std::to_string(calculatePartOne(input, rules)), std::to_string(calculatePartTwo(input, rules))};
 }
 }  // namespace bblp::aoc
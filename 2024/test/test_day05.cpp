@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include "bblp/aoc/scoped_puzzle_input.hpp"
 #include "days.hpp"
 
 namespace bblp::aoc::test {
@@ -8,4 +9,19 @@ TEST(Day5, test) {
     EXPECT_EQ("5091", result.first);
     EXPECT_EQ("4681", result.second);
 }
+
+TEST(Day5, chainedRules) {
+    // Only neighbouring pages are ruled, so the order 10,20,30,40,50 is unique but predecessor counts repeat.
+    const ScopedPuzzleInput input{"day05",
+                                  "10|20\n"
+                                  "20|30\n"
+                                  "30|40\n"
+                                  "40|50\n"
+                                  "\n"
+                                  "20,40,50\n"
+                                  "40,10,50,30,20\n"};
+    const auto result = day05();
+    EXPECT_EQ("40", result.first);
+    EXPECT_EQ("30", result.second);
+}
 };  // namespace bblp::aoc::test
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <optional>
+#include <span>
 #include <vector>
 
 #include "bblp/aoc/point.hpp"
@@ -40,6 +41,21 @@ class Grid {
         return {};
     }
 
+    [[nodiscard]] inline std::span<const TileType> row(const DimensionType y) const {
+        return {mTiles.data() + y * mWidth, static_cast<std::size_t>(mWidth)};
+    }
+
+    [[nodiscard]] Grid transposed() const {
+        std::vector<TileType> tiles;
+        tiles.reserve(mTiles.size());
+        for (DimensionType x = 0; x < mWidth; ++x) {
+            for (DimensionType y = 0; y < mHeight; ++y) {
+                tiles.push_back(mTiles[y * mWidth + x]);
+            }
+        }
+        return Grid(mHeight, mWidth, std::move(tiles));
+    }
+
     void set(const Point& point, TileType value) { set(point.x, point.y, value); }
     void set(const DimensionType x, const DimensionType y, TileType value) { mTiles[y * mWidth + x] = value; }
 
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace bblp::aoc {
+// Splits [0, count) into one contiguous chunk per hardware thread, evaluates `chunkFunction(begin, end)` for every
+// chunk concurrently and returns the sum of the chunk results. The first chunk runs on the calling thread.
+template <typename Result, typename ChunkFunction>
+Result parallelSum(const std::size_t count, const ChunkFunction& chunkFunction) {
+    if (count == 0U) {
+        return Result{};
+    }
+
+    const std::size_t chunkCount = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1U, count);
+    const auto chunkSize = (count + chunkCount - 1U) / chunkCount;
+    std::vector<std::future<Result>> futures;
+    for (std::size_t begin = chunkSize; begin < count; begin += chunkSize) {
+        const auto end = std::min(begin + chunkSize, count);
+        futures.push_back(
+            std::async(std::launch::async, [&chunkFunction, begin, end]() { return chunkFunction(begin, end); }));
+    }
+
+    Result result = chunkFunction(0U, std::min(chunkSize, count));
+    for (auto& future : futures) {
+        result += future.get();
+    }
+    return result;
+}
+
+// Same chunking as parallelSum for work that only writes to chunk-owned output: runs `chunkFunction(begin, end)`
+// for every chunk of [0, count) and returns once all of them have finished.
+template <typename ChunkFunction>
+void parallelFor(const std::size_t count, const ChunkFunction& chunkFunction) {
+    struct NoResult {
+        NoResult& operator+=(const NoResult& /*other*/) { return *this; }
+    };
+
+    parallelSum<NoResult>(count, [&chunkFunction](const std::size_t begin, const std::size_t end) {
+        chunkFunction(begin, end);
+        return NoResult{};
+    });
+}
+}  // namespace bblp::aoc
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bblp::aoc {
+// Collects how long the named phases of a day (parsing, each part) took. Recording is only active between
+// startRecording() and stopRecording(), so days invoked outside of Application (e.g. from tests) cost nothing extra.
+class PhaseTimer {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Phase {
+        std::string name;
+        Clock::duration duration;
+    };
+
+    template <typename Function>
+    static auto measure(const std::string& name, Function&& function) {
+        if (!isRecording()) {
+            return std::forward<Function>(function)();
+        }
+
+        const auto timepointBefore = Clock::now();
+        auto result = std::forward<Function>(function)();
+        record(name, Clock::now() - timepointBefore);
+        return result;
+    }
+
+    static void startRecording();
+    static std::vector<Phase> stopRecording();
+
+  private:
+    static bool isRecording();
+    static void record(const std::string& name, Clock::duration duration);
+};
+}  // namespace bblp::aoc
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+#include "bblp/aoc/point.hpp"
+
+namespace bblp::aoc {
+// Simple polygon on the integer lattice, built edge by edge from a starting vertex and implicitly closed back to it.
+// Only running sums are kept, so the area is available in O(1) memory regardless of the number of edges.
+class LatticePolygon {
+  public:
+    explicit LatticePolygon(const Point& start = {});
+
+    void moveTo(const Point& point);
+    void moveBy(int64_t dx, int64_t dy);
+
+    // Twice the enclosed area (shoelace formula), kept doubled so it stays integral.
+    [[nodiscard]] int64_t doubledArea() const;
+    // Lattice points lying on the edges.
+    [[nodiscard]] int64_t boundaryPoints() const;
+    // Lattice points strictly inside, from Pick's theorem: A = I + B / 2 - 1.
+    [[nodiscard]] int64_t interiorPoints() const;
+    // Lattice points inside or on the boundary.
+    [[nodiscard]] int64_t coveredPoints() const;
+
+  private:
+    Point mStart;
+    Point mCurrent;
+    int64_t mCrossSum;
+    int64_t mBoundary;
+};
+}  // namespace bblp::aoc
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace bblp::aoc {
+// Lets a day run against an inline example instead of the real puzzle input. For its lifetime the working directory
+// is switched to a fresh temporary one whose resources/<dayName>.txt holds the given text, so days read it through
+// their usual path; the previous working directory is restored and the temporary one removed on destruction.
+class ScopedPuzzleInput {
+  public:
+    ScopedPuzzleInput(const std::string& dayName, const std::string& content);
+    ~ScopedPuzzleInput();
+
+    ScopedPuzzleInput(const ScopedPuzzleInput&) = delete;
+    ScopedPuzzleInput& operator=(const ScopedPuzzleInput&) = delete;
+
+  private:
+    std::filesystem::path mPreviousDirectory;
+    std::filesystem::path mDirectory;
+};
+}  // namespace bblp::aoc
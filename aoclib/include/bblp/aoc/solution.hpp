@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "bblp/aoc/phase_timer.hpp"
+
+namespace bblp::aoc {
+namespace detail {
+template <typename Result>
+std::string toResultString(Result&& result) {
+    if constexpr (std::is_convertible_v<Result, std::string>) {
+        return std::string{std::forward<Result>(result)};
+    } else {
+        return std::to_string(result);
+    }
+}
+}  // namespace detail
+
+// Runs `parse` exactly once and lends the parsed input to both parts by const reference, so a day whose parts
+// share the same structures only builds them once. Parsing and each part are timed as separate phases.
+template <typename Parse, typename PartOne, typename PartTwo>
+std::pair<std::string, std::string> solve(Parse&& parse, PartOne&& partOne, PartTwo&& partTwo) {
+    const auto input = PhaseTimer::measure("Parse", std::forward<Parse>(parse));
+    auto partOneResult =
+        PhaseTimer::measure("Part 1", [&input, &partOne]() { return detail::toResultString(partOne(input)); });
+    auto partTwoResult =
+        PhaseTimer::measure("Part 2", [&input, &partTwo]() { return detail::toResultString(partTwo(input)); });
+    return {std::move(partOneResult), std::move(partTwoResult)};
+}
+}  // namespace bblp::aoc
@@ -1,4 +1,5 @@
 #include "bblp/aoc/application.hpp"
+#include "bblp/aoc/phase_timer.hpp"
 
 #include <algorithm>
 #include <chrono>
@@ -33,12 +34,18 @@ void Application::run(DayFunction dayFunction) {
         throw std::logic_error("No solution for requested day");
     }
 
+    PhaseTimer::startRecording();
     const auto timepointBefore = std::chrono::system_clock::now();
     const auto result = dayFunctionToRun();
     const auto timepointAfter = std::chrono::system_clock::now();
     const auto elapsedTime = timepointAfter - timepointBefore;
+    const auto phases = PhaseTimer::stopRecording();
     std::cout << "Part 1 result: " << result.first << '\n';
     std::cout << "Part 2 result: " << result.second << '\n';
+    for (const auto& phase : phases) {
+        const auto phaseTime = std::chrono::duration<double, std::milli>(phase.duration);
+        std::cout << phase.name << " time: " << phaseTime.count() << "ms" << '\n';
+    }
     std::cout << "Elapsed time: " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsedTime).count() << "ms"
               << '\n';
 }
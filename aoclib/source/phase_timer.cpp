@@ -0,0 +1,33 @@
+#include "bblp/aoc/phase_timer.hpp"
+
+namespace bblp::aoc {
+namespace {
+struct Recording {
+    bool active{false};
+    std::vector<PhaseTimer::Phase> phases;
+};
+
+Recording& recording() {
+    static Recording instance;
+    return instance;
+}
+}  // namespace
+
+void PhaseTimer::startRecording() {
+    recording().phases.clear();
+    recording().active = true;
+}
+
+std::vector<PhaseTimer::Phase> PhaseTimer::stopRecording() {
+    recording().active = false;
+    return std::move(recording().phases);
+}
+
+bool PhaseTimer::isRecording() {
+    return recording().active;
+}
+
+void PhaseTimer::record(const std::string& name, const Clock::duration duration) {
+    recording().phases.push_back(Phase{name, duration});
+}
+}  // namespace bblp::aoc
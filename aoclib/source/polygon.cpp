@@ -0,0 +1,44 @@
+#include "bblp/aoc/polygon.hpp"
+
+#include <cstdlib>
+#include <numeric>
+
+namespace bblp::aoc {
+namespace {
+int64_t cross(const Point& lhs, const Point& rhs) {
+    return lhs.x * rhs.y - lhs.y * rhs.x;
+}
+
+int64_t latticeStepsBetween(const Point& lhs, const Point& rhs) {
+    return std::gcd(std::abs(rhs.x - lhs.x), std::abs(rhs.y - lhs.y));
+}
+}  // namespace
+
+LatticePolygon::LatticePolygon(const Point& start) : mStart(start), mCurrent(start), mCrossSum(0), mBoundary(0) {}
+
+void LatticePolygon::moveTo(const Point& point) {
+    mCrossSum += cross(mCurrent, point);
+    mBoundary += latticeStepsBetween(mCurrent, point);
+    mCurrent = point;
+}
+
+void LatticePolygon::moveBy(const int64_t dx, const int64_t dy) {
+    moveTo(Point{mCurrent.x + dx, mCurrent.y + dy});
+}
+
+int64_t LatticePolygon::doubledArea() const {
+    return std::abs(mCrossSum + cross(mCurrent, mStart));
+}
+
+int64_t LatticePolygon::boundaryPoints() const {
+    return mBoundary + latticeStepsBetween(mCurrent, mStart);
+}
+
+int64_t LatticePolygon::interiorPoints() const {
+    return (doubledArea() - boundaryPoints()) / 2 + 1;
+}
+
+int64_t LatticePolygon::coveredPoints() const {
+    return interiorPoints() + boundaryPoints();
+}
+}  // namespace bblp::aoc
@@ -0,0 +1,29 @@
+#include "bblp/aoc/scoped_puzzle_input.hpp"
+
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+
+namespace bblp::aoc {
+ScopedPuzzleInput::ScopedPuzzleInput(const std::string& dayName, const std::string& content)
+    : mPreviousDirectory(std::filesystem::current_path()),
+      mDirectory(std::filesystem::temp_directory_path() /
+                 ("aoc_" + dayName + "_" + std::to_string(std::random_device{}()))) {
+    std::filesystem::create_directories(mDirectory / "resources");
+    {
+        std::ofstream file(mDirectory / "resources" / (dayName + ".txt"));
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file");
+        }
+        file << content;
+    }
+    std::filesystem::current_path(mDirectory);
+}
+
+ScopedPuzzleInput::~ScopedPuzzleInput() {
+    std::error_code error;
+    std::filesystem::current_path(mPreviousDirectory, error);
+    std::filesystem::remove_all(mDirectory, error);
+}
+}  // namespace bblp::aoc